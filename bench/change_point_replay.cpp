@@ -0,0 +1,197 @@
+// Replays the scene transition detector over a frame trace (frame_trace.csv, recorded with
+// frameTraceEnabled) and reports what it detects, so its thresholds and transitionHoldMs can be
+// checked against real sessions. With the default settings it should find the change points the
+// app recorded, anything else is the effect of the settings passed.
+// Usage: change_point_replay <frame_trace.csv> [--hold-ms N] [--max-hold-ms N]
+//        [--frame-delta X] [--frame-threshold X] [--usage-delta X] [--usage-threshold X]
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "change_point.h"
+#include "trace.h"
+
+// A replayed change point this close to a recorded one is the same detection
+static constexpr const double matchWindowS = 0.5;
+
+struct Transition
+{
+	double startS = 0;
+	double endS = 0;
+};
+
+/// Follows a transition flag over the rows, closing the last transition at endS
+struct TransitionTimeline
+{
+	std::vector<Transition> transitions;
+	bool inTransition = false;
+};
+
+static void updateTimeline(TransitionTimeline &timeline, bool inTransition, double timeS)
+{
+	if (inTransition && !timeline.inTransition)
+		timeline.transitions.push_back({timeS, timeS});
+	if (inTransition || timeline.inTransition)
+		timeline.transitions.back().endS = timeS;
+	timeline.inTransition = inTransition;
+}
+
+static double totalSeconds(const TransitionTimeline &timeline)
+{
+	double total = 0;
+	for (const Transition &transition : timeline.transitions)
+		total += transition.endS - transition.startS;
+	return total;
+}
+
+/// Counts the times in a that have one in b within matchWindowS, both sorted
+static int countMatches(const std::vector<double> &a, const std::vector<double> &b)
+{
+	int matches = 0;
+	size_t j = 0;
+	for (double time : a)
+	{
+		while (j < b.size() && b[j] < time - matchWindowS)
+			j++;
+		if (j < b.size() && std::fabs(b[j] - time) <= matchWindowS)
+			matches++;
+	}
+	return matches;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2 || argc % 2 != 0)
+	{
+		fprintf(stderr, "Usage: %s <frame_trace.csv> [--hold-ms N] [--max-hold-ms N] [--frame-delta X] [--frame-threshold X] [--usage-delta X] [--usage-threshold X]\n", argv[0]);
+		return 2;
+	}
+
+	// The app's defaults (transitionHoldMs and its maximum hold)
+	int holdMs = 3000;
+	int maxHoldMs = 30000;
+	TransitionDetector detector;
+	for (int i = 2; i < argc; i += 2)
+	{
+		const char *value = argv[i + 1];
+		if (strcmp(argv[i], "--hold-ms") == 0)
+			holdMs = atoi(value);
+		else if (strcmp(argv[i], "--max-hold-ms") == 0)
+			maxHoldMs = atoi(value);
+		else if (strcmp(argv[i], "--frame-delta") == 0)
+			detector.thresholds.frameDelta = (float)atof(value);
+		else if (strcmp(argv[i], "--frame-threshold") == 0)
+			detector.thresholds.frameThreshold = (float)atof(value);
+		else if (strcmp(argv[i], "--usage-delta") == 0)
+			detector.thresholds.usageDelta = (float)atof(value);
+		else if (strcmp(argv[i], "--usage-threshold") == 0)
+			detector.thresholds.usageThreshold = (float)atof(value);
+		else
+		{
+			fprintf(stderr, "Unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+
+	FILE *file = fopen(argv[1], "r");
+	if (!file)
+	{
+		fprintf(stderr, "%s can't be read\n", argv[1]);
+		return 1;
+	}
+	char line[256];
+	if (!fgets(line, sizeof(line), file) || strcmp(line, frameTraceHeader) != 0)
+	{
+		fprintf(stderr, "%s isn't a frame trace of this version, expected the columns:\n%s", argv[1], frameTraceHeader);
+		fclose(file);
+		return 1;
+	}
+
+	int frames = 0;
+	int fedFrames = 0;
+	int usageSamples = 0;
+	int resets = 0;
+	int frameChangePoints = 0;
+	int usageChangePoints = 0;
+	double firstTimeS = -1;
+	double lastTimeS = 0;
+	std::vector<double> replayedChangePoints;
+	std::vector<double> recordedChangePoints;
+	TransitionTimeline replayed;
+	TransitionTimeline recorded;
+
+	for (int lineNumber = 2; fgets(line, sizeof(line), file); lineNumber++)
+	{
+		FrameTraceRow row;
+		char event[16];
+		int settling, changePoint, transition;
+		if (sscanf(line, "%lf,%15[^,],%u,%f,%f,%d,%d,%d,%d", &row.timeS, event, &row.frameIndex, &row.gpuTime, &row.cpuTime,
+				   &row.gpuUsage, &settling, &changePoint, &transition) != 9)
+		{
+			fprintf(stderr, "%s:%d: malformed row, skipped\n", argv[1], lineNumber);
+			continue;
+		}
+		if (firstTimeS < 0)
+			firstTimeS = row.timeS;
+		lastTimeS = row.timeS;
+		if (changePoint)
+			recordedChangePoints.push_back(row.timeS);
+		updateTimeline(recorded, transition != 0, row.timeS);
+
+		// Fed to the detector the way the app does
+		bool detected = false;
+		if (strcmp(event, frameTraceEvents[(int)FrameTraceEvent::Frame]) == 0)
+		{
+			frames++;
+			if (!settling)
+			{
+				fedFrames++;
+				detected = updateTransitionTimes(detector, row.gpuTime, row.cpuTime, row.timeS);
+				frameChangePoints += detected;
+			}
+		}
+		else if (strcmp(event, frameTraceEvents[(int)FrameTraceEvent::Usage]) == 0)
+		{
+			usageSamples++;
+			if (!settling)
+			{
+				detected = updateTransitionUsage(detector, (float)row.gpuUsage, row.timeS);
+				usageChangePoints += detected;
+			}
+		}
+		else if (strcmp(event, frameTraceEvents[(int)FrameTraceEvent::Reset]) == 0)
+		{
+			resets++;
+			resetTransitionBaseline(detector);
+		}
+		if (detected)
+			replayedChangePoints.push_back(row.timeS);
+
+		// The app only checks at its decisions, checking every row ends transitions a bit more precisely
+		updateTimeline(replayed, isInTransition(detector, row.timeS, holdMs, maxHoldMs), row.timeS);
+	}
+	fclose(file);
+
+	double durationS = firstTimeS < 0 ? 0 : lastTimeS - firstTimeS;
+	printf("%d frames (%d fed to the detector), %d GPU usage samples, %d baseline resets over %.1f s\n",
+		   frames, fedFrames, usageSamples, resets, durationS);
+	printf("Settings: hold %d ms (at most %d ms), frame delta %.3f threshold %.2f, usage delta %.3f threshold %.2f\n",
+		   holdMs, maxHoldMs, detector.thresholds.frameDelta, detector.thresholds.frameThreshold,
+		   detector.thresholds.usageDelta, detector.thresholds.usageThreshold);
+	printf("Change points: %zu replayed (%d frametime, %d GPU usage), %zu recorded, %d replayed within %.1f s of a recorded one\n",
+		   replayedChangePoints.size(), frameChangePoints, usageChangePoints, recordedChangePoints.size(),
+		   countMatches(replayedChangePoints, recordedChangePoints), matchWindowS);
+
+	double replayedS = totalSeconds(replayed);
+	double recordedS = totalSeconds(recorded);
+	printf("Transitions: %zu replayed for %.1f s (%.1f%% of the time), %zu recorded for %.1f s (%.1f%%, none if transitionDetection was off)\n",
+		   replayed.transitions.size(), replayedS, durationS > 0 ? replayedS * 100 / durationS : 0,
+		   recorded.transitions.size(), recordedS, durationS > 0 ? recordedS * 100 / durationS : 0);
+	for (const Transition &transition : replayed.transitions)
+		printf("  %10.3f s - %10.3f s (%.1f s)\n", transition.startS - firstTimeS, transition.endS - firstTimeS, transition.endS - transition.startS);
+	return 0;
+}
@@ -0,0 +1,149 @@
+// Compares walking the frame history structs (as the averaging loop used to)
+// with the column reductions, for windows from OpenVR's 128 frames up to 10k.
+// "struct means" is the old loop, "struct stats" the old loop computing the same statistics as the columns.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "frame_history.h"
+
+// The old loop only summed a few fields per frame
+static float reduceAosMeans(const FrameHistory &history, int frames, float *means)
+{
+	std::fill(means, means + (int)FrameColumn::Count, 0.0f);
+	for (int age = 0; age < frames; age++)
+	{
+		const vr::Compositor_FrameTiming &frame = getHistoryFrame(history, age);
+		float applicationCpu = frame.m_flNewFrameReadyMs - frame.m_flNewPosesReadyMs;
+		means[(int)FrameColumn::GpuTime] += frame.m_flTotalRenderGpuMs;
+		means[(int)FrameColumn::CpuTime] += frame.m_flCompositorRenderCpuMs + applicationCpu;
+		means[(int)FrameColumn::Presents] += (float)std::max((int)frame.m_nNumFramePresents, 1);
+		means[(int)FrameColumn::PreSubmitGpu] += frame.m_flPreSubmitGpuMs;
+		means[(int)FrameColumn::PostSubmitGpu] += frame.m_flPostSubmitGpuMs;
+		means[(int)FrameColumn::CompositorRenderGpu] += frame.m_flCompositorRenderGpuMs;
+		means[(int)FrameColumn::ApplicationCpu] += applicationCpu;
+		means[(int)FrameColumn::CompositorRenderCpu] += frame.m_flCompositorRenderCpuMs;
+		means[(int)FrameColumn::CompositorIdleCpu] += frame.m_flCompositorIdleCpuMs;
+		means[(int)FrameColumn::WaitForPresentCpu] += frame.m_flWaitForPresentCpuMs;
+		means[(int)FrameColumn::SubmitFrame] += frame.m_flSubmitFrameMs;
+	}
+	return means[(int)FrameColumn::GpuTime] / frames;
+}
+
+// The same loop computing what the columns compute: variance, min/max and frametime histograms
+static float reduceAosStats(const FrameHistory &history, int frames, float histogramMax, ColumnStats *stats)
+{
+	float sums[(int)FrameColumn::Count] = {};
+	float squares[(int)FrameColumn::Count] = {};
+	for (int column = 0; column < (int)FrameColumn::Count; column++)
+	{
+		stats[column] = ColumnStats();
+		stats[column].min = INFINITY;
+		stats[column].max = -INFINITY;
+	}
+
+	for (int age = 0; age < frames; age++)
+	{
+		const vr::Compositor_FrameTiming &frame = getHistoryFrame(history, age);
+		float applicationCpu = frame.m_flNewFrameReadyMs - frame.m_flNewPosesReadyMs;
+		float values[(int)FrameColumn::Count] = {
+			frame.m_flTotalRenderGpuMs,
+			frame.m_flCompositorRenderCpuMs + applicationCpu,
+			(float)std::max((int)frame.m_nNumFramePresents, 1),
+			frame.m_flPreSubmitGpuMs,
+			frame.m_flPostSubmitGpuMs,
+			frame.m_flCompositorRenderGpuMs,
+			applicationCpu,
+			frame.m_flCompositorRenderCpuMs,
+			frame.m_flCompositorIdleCpuMs,
+			frame.m_flWaitForPresentCpuMs,
+			frame.m_flSubmitFrameMs,
+		};
+		for (int column = 0; column < (int)FrameColumn::Count; column++)
+		{
+			float value = values[column];
+			sums[column] += value;
+			squares[column] += value * value;
+			stats[column].min = std::min(stats[column].min, value);
+			stats[column].max = std::max(stats[column].max, value);
+		}
+		for (int column = 0; column <= (int)FrameColumn::CpuTime; column++)
+		{
+			int bucket = (int)(values[column] * columnHistogramBuckets / histogramMax);
+			stats[column].histogram[std::clamp(bucket, 0, columnHistogramBuckets - 1)]++;
+		}
+	}
+
+	for (int column = 0; column < (int)FrameColumn::Count; column++)
+	{
+		stats[column].mean = sums[column] / frames;
+		stats[column].variance = squares[column] / frames - stats[column].mean * stats[column].mean;
+	}
+	return stats[(int)FrameColumn::GpuTime].mean;
+}
+
+// Called through volatile pointers so the compiler can't inline them and hoist the work out of the timing loops
+static float (*volatile reduceMeans)(const FrameHistory &, int, float *) = reduceAosMeans;
+static float (*volatile reduceStats)(const FrameHistory &, int, float, ColumnStats *) = reduceAosStats;
+static void (*volatile reduceColumns)(const FrameColumns &, int, float, ColumnStats *) = reduceFrameColumns;
+
+template <typename F>
+static double timeNs(int iterations, F function)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		function();
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main()
+{
+	std::mt19937 random(1);
+	std::normal_distribution<float> noise(1.0f, 0.1f);
+
+	const int windows[] = {128, 512, 1024, 4096, 10000};
+	printf("%8s %16s %16s %16s %8s\n", "frames", "struct means", "struct stats", "column stats", "speedup");
+	for (int frames : windows)
+	{
+		FrameHistory history;
+		initFrameHistory(history, frames);
+		// Ingest more than the capacity so both rings have wrapped
+		for (int i = 1; i <= frames * 2; i++)
+		{
+			vr::Compositor_FrameTiming frame = {};
+			frame.m_nFrameIndex = i;
+			frame.m_nNumFramePresents = 1;
+			frame.m_flSystemTimeInSeconds = i / 90.0;
+			frame.m_flTotalRenderGpuMs = 8 * noise(random);
+			frame.m_flPreSubmitGpuMs = 6 * noise(random);
+			frame.m_flPostSubmitGpuMs = 0.5f * noise(random);
+			frame.m_flCompositorRenderGpuMs = 1 * noise(random);
+			frame.m_flCompositorRenderCpuMs = 1 * noise(random);
+			frame.m_flNewPosesReadyMs = 1 * noise(random);
+			frame.m_flNewFrameReadyMs = frame.m_flNewPosesReadyMs + 5 * noise(random);
+			ingestFrames(history, &frame, 1);
+		}
+
+		int iterations = std::max(2000000 / frames, 100);
+		float means[(int)FrameColumn::Count];
+		ColumnStats aosStats[(int)FrameColumn::Count];
+		ColumnStats columnStats[(int)FrameColumn::Count];
+		float meansGpu = 0, aosGpu = 0;
+		double meansNs = timeNs(iterations, [&]
+								{ meansGpu = reduceMeans(history, frames, means); });
+		double aosNs = timeNs(iterations, [&]
+							  { aosGpu = reduceStats(history, frames, 22.2f, aosStats); });
+		double columnsNs = timeNs(iterations, [&]
+								  { reduceColumns(history.columns, frames, 22.2f, columnStats); });
+
+		// Check they agree so none gets optimised away
+		float columnsGpu = columnStats[(int)FrameColumn::GpuTime].mean;
+		if (std::abs(meansGpu - columnsGpu) > 0.01f || std::abs(aosGpu - columnsGpu) > 0.01f)
+			printf("mismatch: %f %f %f\n", meansGpu, aosGpu, columnsGpu);
+		printf("%8d %13.0f ns %13.0f ns %13.0f ns %7.1fx\n", frames, meansNs, aosNs, columnsNs, aosNs / columnsNs);
+	}
+	return 0;
+}
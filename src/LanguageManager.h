@@ -1,32 +1,66 @@
 #pragma once
-#include <unordered_map>
 #include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "translations.h"
 
 class LanguageManager {
 public:
-    enum Language {
-        ENGLISH,
-        SIMPLIFIED_CHINESE,
-        JAPANESE
-    };
-
     static LanguageManager& getInstance() {
         static LanguageManager instance;
         return instance;
     }
 
-    void setLanguage(Language lang);
-    std::string translate(const std::string& key);
+    /**
+     * Selects a language of the list: 0 is the built-in English, the others are catalogs.
+     * Falls back to English if the catalog can't be loaded.
+     */
+    void setLanguage(size_t index);
+
+    size_t getLanguageCount() const { return languageNames.size(); }
+    const char *getLanguageName(size_t index) const { return languageNames[index].c_str(); }
+
+    /// Text of id in the current language, an index into the catalog (no copy)
+    const char *translate(Str id) const {
+        return translateView(id).data();
+    }
+
+    std::string_view translateView(Str id) const {
+        return catalogStrings ? catalogStrings[(size_t)id] : builtinTranslations[(size_t)id];
+    }
 
 private:
     LanguageManager();
-    Language currentLanguage;
-    std::unordered_map<std::string, std::unordered_map<Language, std::string>> translations;
+    /// Lists English and the catalogs in the translations directory
+    void findLanguages();
 
-    void initializeTranslations();
-    
+    std::vector<std::string> languageCodes; // Catalog file names without the extension, empty for English
+    std::vector<std::string> languageNames;
+    size_t currentLanguage = 0;
+    const std::string_view *catalogStrings = nullptr; // Of the loaded catalog, nullptr for English
 };
 
+/// Buffer the translations are formatted into, reused so formatting doesn't allocate once it's big enough
+fmt::memory_buffer &getTranslationBuffer();
+
+/**
+ * Formats the translation of id with args. The number of arguments is checked against
+ * the placeholders when compiling. The text is valid until the next call.
+ */
+template <Str id, typename... Args>
+const char *formatTranslation(const Args &...args)
+{
+    static_assert(countPlaceholders(builtinTranslations[(size_t)id]) == sizeof...(Args), "Wrong number of arguments for this translation");
+
+    fmt::memory_buffer &buffer = getTranslationBuffer();
+    buffer.clear();
+    fmt::vformat_to(fmt::appender(buffer), LanguageManager::getInstance().translateView(id), fmt::make_format_args(args...));
+    buffer.push_back('\0');
+    return buffer.data();
+}
+
 
 void InitImGuiWithChineseFonts();
 void setLanguage(int language);
@@ -0,0 +1,124 @@
+#include "app_matcher.h"
+
+#include <algorithm>
+
+/// Matches text against a pattern of literal characters, * (any run) and ? (any character)
+static bool globMatch(const char *pattern, const char *text)
+{
+	const char *starPattern = nullptr;
+	const char *starText = nullptr;
+	while (*text)
+	{
+		if (*pattern == '*')
+		{
+			// Try matching nothing first, come back to take one more character
+			starPattern = ++pattern;
+			starText = text;
+		}
+		else if (*pattern == '?' || *pattern == *text)
+		{
+			pattern++;
+			text++;
+		}
+		else if (starPattern)
+		{
+			pattern = starPattern;
+			text = ++starText;
+		}
+		else
+			return false;
+	}
+	while (*pattern == '*')
+		pattern++;
+	return !*pattern;
+}
+
+static uint32_t findChild(const AppMatcher::TrieNode &node, char c)
+{
+	auto child = std::lower_bound(node.children.begin(), node.children.end(), c, [](const std::pair<char, uint32_t> &entry, char c)
+								  { return entry.first < c; });
+	return child != node.children.end() && child->first == c ? child->second : 0;
+}
+
+bool isAppPattern(const std::string &rule)
+{
+	return rule.find_first_of("*?") != std::string::npos;
+}
+
+std::shared_ptr<const AppMatcher> compileAppMatcher(const std::set<std::string> &rules, const std::shared_ptr<const AppMatcher> &previous)
+{
+	if (previous && previous->rules == rules)
+		return previous;
+
+	auto matcher = std::make_shared<AppMatcher>();
+	matcher->rules = rules;
+	matcher->trie.emplace_back();
+	for (const std::string &rule : rules)
+	{
+		size_t wildcard = rule.find_first_of("*?");
+		if (wildcard == std::string::npos)
+		{
+			// Already sorted, coming from a set
+			matcher->exact.push_back(rule);
+			continue;
+		}
+
+		// Walk down the literal prefix, adding the missing nodes
+		uint32_t node = 0;
+		for (size_t i = 0; i < wildcard; i++)
+		{
+			uint32_t child = findChild(matcher->trie[node], rule[i]);
+			if (!child)
+			{
+				child = (uint32_t)matcher->trie.size();
+				auto &children = matcher->trie[node].children;
+				children.insert(std::upper_bound(children.begin(), children.end(), std::make_pair(rule[i], 0u)), {rule[i], child});
+				matcher->trie.emplace_back();
+			}
+			node = child;
+		}
+
+		if (rule.find_first_not_of('*', wildcard) == std::string::npos)
+			matcher->trie[node].prefixRule = true;
+		else
+		{
+			matcher->trie[node].globs.push_back((uint32_t)matcher->globs.size());
+			matcher->globs.push_back(rule.substr(wildcard));
+		}
+	}
+	return matcher;
+}
+
+bool matchApp(const AppMatcher &matcher, const std::string &appKey)
+{
+	bool matched = std::binary_search(matcher.exact.begin(), matcher.exact.end(), appKey);
+	uint32_t node = 0;
+	for (size_t depth = 0; !matched; depth++)
+	{
+		const AppMatcher::TrieNode &trieNode = matcher.trie[node];
+		matched = trieNode.prefixRule;
+		for (size_t i = 0; i < trieNode.globs.size() && !matched; i++)
+			matched = globMatch(matcher.globs[trieNode.globs[i]].c_str(), appKey.c_str() + depth);
+
+		if (depth == appKey.size() || !(node = findChild(trieNode, appKey[depth])))
+			break;
+	}
+
+	return matched;
+}
+
+bool matchApp(AppMatchCache &cache, const std::shared_ptr<const AppMatcher> &matcher, const std::string &appKey)
+{
+	if (cache.matcher != matcher)
+	{
+		cache.matcher = matcher;
+		cache.results.clear();
+	}
+
+	auto cached = cache.results.find(appKey);
+	if (cached != cache.results.end())
+		return cached->second;
+	bool matched = matchApp(*matcher, appKey);
+	cache.results.emplace(appKey, matched);
+	return matched;
+}
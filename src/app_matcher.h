@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * App key rules compiled for matching: exact keys, prefixes (steam.app.2177*)
+ * and globs with * and ? anywhere (system.generated.*.exe).
+ * Exact keys are a sorted flat table, the other rules hang off a prefix trie
+ * by the literal text before their first wildcard.
+ */
+struct AppMatcher
+{
+	struct TrieNode
+	{
+		std::vector<std::pair<char, uint32_t>> children; // Sorted by character
+		bool prefixRule = false;						  // A rule ends with * right here, anything below matches
+		std::vector<uint32_t> globs;					  // Rules continuing with a wildcard from here, indices into globs
+	};
+
+	std::set<std::string> rules; // What it was compiled from
+	std::vector<std::string> exact;
+	std::vector<TrieNode> trie; // Root first
+	std::vector<std::string> globs;
+};
+
+/**
+ * Results of one matcher by app key. Owned by the thread matching, never put in a
+ * Config snapshot: those are read from several threads.
+ */
+struct AppMatchCache
+{
+	std::shared_ptr<const AppMatcher> matcher; // The results are for this one
+	std::unordered_map<std::string, bool> results;
+};
+
+/// Whether an app key rule has wildcards
+bool isAppPattern(const std::string &rule);
+
+/// Compiles rules. If previous was compiled from the same rules it's returned instead.
+std::shared_ptr<const AppMatcher> compileAppMatcher(const std::set<std::string> &rules, const std::shared_ptr<const AppMatcher> &previous = nullptr);
+
+/// Whether appKey matches any rule
+bool matchApp(const AppMatcher &matcher, const std::string &appKey);
+
+/// matchApp looked up once per app key, the cache is cleared when given another matcher
+bool matchApp(AppMatchCache &cache, const std::shared_ptr<const AppMatcher> &matcher, const std::string &appKey);
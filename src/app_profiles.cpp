@@ -0,0 +1,75 @@
+#include "app_profiles.h"
+
+#include <cstring>
+#include <iostream>
+
+#include <fmt/core.h>
+
+bool isSettingOverridable(const SettingDesc &setting)
+{
+	// Startup settings apply before any app runs, the app lists are replaced by the enabled key
+	return strcmp(setting.section, "Startup") != 0 && setting.type != SettingType::AppList;
+}
+
+void parseAppProfiles(const CSimpleIniA &ini, std::map<std::string, AppProfile> &profiles)
+{
+	profiles.clear();
+
+	CSimpleIniA::TNamesDepend sections;
+	ini.GetAllSections(sections);
+	size_t prefixLength = strlen(appProfileSectionPrefix);
+	for (const auto &section : sections)
+	{
+		if (strncmp(section.pItem, appProfileSectionPrefix, prefixLength) != 0 || !section.pItem[prefixLength])
+			continue;
+
+		CSimpleIniA::TNamesDepend keys;
+		ini.GetAllKeys(section.pItem, keys);
+		AppProfile &profile = profiles[section.pItem + prefixLength];
+		for (const auto &key : keys)
+			profile[key.pItem] = ini.GetValue(section.pItem, key.pItem, "");
+	}
+}
+
+void serializeAppProfiles(CSimpleIniA &ini, const std::map<std::string, AppProfile> &profiles)
+{
+	for (const auto &[appKey, profile] : profiles)
+	{
+		std::string section = appProfileSectionPrefix + appKey;
+		for (const auto &[key, value] : profile)
+			ini.SetValue(section.c_str(), key.c_str(), value.c_str());
+	}
+}
+
+int resolveAppProfile(Config &config, const std::string &appKey, const SettingDesc *table, size_t count)
+{
+	config.profileEnabled = AppEnabled::Default;
+	auto profile = config.appProfiles.find(appKey);
+	if (appKey.empty() || profile == config.appProfiles.end())
+		return 0;
+
+	int applied = 0;
+	for (const auto &[key, value] : profile->second)
+	{
+		if (key == appProfileEnabledKey)
+		{
+			if (value == "0" || value == "1")
+			{
+				config.profileEnabled = value == "1" ? AppEnabled::Enabled : AppEnabled::Disabled;
+				applied++;
+				continue;
+			}
+		}
+		else
+		{
+			const SettingDesc *setting = findSetting(table, count, key.c_str());
+			if (setting && isSettingOverridable(*setting) && parseSetting(*setting, value.c_str(), config))
+			{
+				applied++;
+				continue;
+			}
+		}
+		std::cout << fmt::format("Invalid override {} = \"{}\" in the profile of {}, ignoring it", key, value, appKey) << std::endl;
+	}
+	return applied;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include "SimpleIni.h"
+
+#include "config.h"
+#include "settings_schema.h"
+
+/**
+ * Per-app profiles: [App:<app key>] sections of settings.ini holding settings
+ * that override the global ones while that app is the scene app.
+ */
+
+constexpr const char *appProfileSectionPrefix = "App:";
+/// Profile key turning the app on (1) or off (0), taking precedence over the whitelist and blacklist
+constexpr const char *appProfileEnabledKey = "enabled";
+
+/// Whether a setting can be overridden in a profile
+bool isSettingOverridable(const SettingDesc &setting);
+
+/// Reads every profile section of ini into profiles, replacing them
+void parseAppProfiles(const CSimpleIniA &ini, std::map<std::string, AppProfile> &profiles);
+
+/// Writes a section for every profile that has overrides
+void serializeAppProfiles(CSimpleIniA &ini, const std::map<std::string, AppProfile> &profiles);
+
+/**
+ * Layers the profile of appKey (if it has one) over the settings of config.
+ * Overrides that aren't overridable settings or don't parse are logged and skipped.
+ * Returns the number of overrides applied.
+ */
+int resolveAppProfile(Config &config, const std::string &appKey, const SettingDesc *table, size_t count);
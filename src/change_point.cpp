@@ -0,0 +1,106 @@
+#include "change_point.h"
+
+#include <algorithm>
+
+// Samples needed to learn the mean before testing
+static constexpr const int warmupSamples = 30;
+static constexpr const int usageWarmupSamples = 3;
+
+static void restartPageHinkley(PageHinkley &test, float value)
+{
+	test = PageHinkley();
+	test.mean = value;
+	test.count = 1;
+}
+
+bool updatePageHinkley(PageHinkley &test, float value, float delta, float threshold)
+{
+	if (test.count == 0)
+	{
+		restartPageHinkley(test, value);
+		return false;
+	}
+
+	test.count++;
+	test.mean += (value - test.mean) / test.count;
+	float scale = std::max(test.mean, 0.001f);
+
+	float deviation = (value - test.mean) / scale;
+	test.upSum += deviation - delta;
+	test.upMin = std::min(test.upMin, test.upSum);
+	test.downSum += deviation + delta;
+	test.downMax = std::max(test.downMax, test.downSum);
+
+	if (test.upSum - test.upMin > threshold || test.downMax - test.downSum > threshold)
+	{
+		// Learn the new regime from here
+		restartPageHinkley(test, value);
+		return true;
+	}
+	return false;
+}
+
+static void markChange(TransitionDetector &detector, double timeS)
+{
+	if (!detector.inTransition)
+		detector.transitionStartS = timeS;
+	detector.inTransition = true;
+	detector.lastChangeS = timeS;
+	detector.changePoints++;
+}
+
+float getTransitionCpuTime(const vr::Compositor_FrameTiming &frame)
+{
+	return frame.m_flCompositorRenderCpuMs + (frame.m_flNewFrameReadyMs - frame.m_flNewPosesReadyMs);
+}
+
+bool updateTransitionFrame(TransitionDetector &detector, const vr::Compositor_FrameTiming &frame)
+{
+	return updateTransitionTimes(detector, frame.m_flTotalRenderGpuMs, getTransitionCpuTime(frame), frame.m_flSystemTimeInSeconds);
+}
+
+bool updateTransitionTimes(TransitionDetector &detector, float gpuTime, float cpuTime, double timeS)
+{
+	const ChangePointThresholds &thresholds = detector.thresholds;
+
+	// Each test restarts on its own detections, so each needs its own warm-up
+	bool gpuWarm = detector.gpuTime.count >= warmupSamples;
+	bool cpuWarm = detector.cpuTime.count >= warmupSamples;
+	bool gpuChange = updatePageHinkley(detector.gpuTime, gpuTime, thresholds.frameDelta, thresholds.frameThreshold) && gpuWarm;
+	bool cpuChange = updatePageHinkley(detector.cpuTime, cpuTime, thresholds.frameDelta, thresholds.frameThreshold) && cpuWarm;
+	if (gpuChange || cpuChange)
+	{
+		markChange(detector, timeS);
+		return true;
+	}
+	return false;
+}
+
+bool updateTransitionUsage(TransitionDetector &detector, float gpuUsage, double timeS)
+{
+	bool warm = detector.gpuUsage.count >= usageWarmupSamples;
+	if (updatePageHinkley(detector.gpuUsage, gpuUsage, detector.thresholds.usageDelta, detector.thresholds.usageThreshold) && warm)
+	{
+		markChange(detector, timeS);
+		return true;
+	}
+	return false;
+}
+
+void resetTransitionBaseline(TransitionDetector &detector)
+{
+	detector.gpuTime = PageHinkley();
+	detector.cpuTime = PageHinkley();
+	detector.gpuUsage = PageHinkley();
+}
+
+bool isInTransition(TransitionDetector &detector, double nowS, int holdMs, int maxHoldMs)
+{
+	if (!detector.inTransition)
+		return false;
+
+	// Stable again once no shift was seen for a while, but never freeze forever on a noisy app
+	if ((nowS - detector.lastChangeS) * 1000.0 >= holdMs || (nowS - detector.transitionStartS) * 1000.0 >= maxHoldMs)
+		detector.inTransition = false;
+	return detector.inTransition;
+}
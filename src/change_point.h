@@ -0,0 +1,74 @@
+#pragma once
+
+#include <openvr.h>
+
+/**
+ * Two-sided Page-Hinkley test detecting a lasting shift in the mean of a signal.
+ * Deviations are relative to the running mean so the same settings work
+ * for frametimes of 5 ms and 20 ms.
+ */
+struct PageHinkley
+{
+	float mean = 0;
+	int count = 0;
+	float upSum = 0;   // Cumulative deviation above the mean
+	float upMin = 0;
+	float downSum = 0; // Cumulative deviation below the mean
+	float downMax = 0;
+};
+
+/**
+ * Adds value to test. delta is the tolerated deviation and threshold the
+ * cumulative deviation that signals a change, both as a fraction of the mean.
+ * Returns true when a change is detected, after which the test restarts on the new regime.
+ */
+bool updatePageHinkley(PageHinkley &test, float value, float delta, float threshold);
+
+/**
+ * Page-Hinkley settings of the transition detector, as fractions of the mean.
+ * Per-frame signals ignore deviations under 10% of the mean and flag a change once
+ * the accumulated deviation reaches 3 frames' worth of the mean (e.g. 6 frames 60% slower).
+ * GPU utilization is only sampled once per decision, so it reacts to fewer samples.
+ */
+struct ChangePointThresholds
+{
+	float frameDelta = 0.1f;
+	float frameThreshold = 3.0f;
+	float usageDelta = 0.05f;
+	float usageThreshold = 0.5f;
+};
+
+/**
+ * Detects scene transitions (loading screens, level changes...) from shifts in
+ * GPU/CPU frametimes and GPU utilization, and stays in transition until
+ * no shift was seen for holdMs.
+ */
+struct TransitionDetector
+{
+	ChangePointThresholds thresholds;
+	PageHinkley gpuTime;
+	PageHinkley cpuTime;
+	PageHinkley gpuUsage;
+	bool inTransition = false;
+	double lastChangeS = 0; // Compositor time of the last detected shift
+	double transitionStartS = 0;
+	int changePoints = 0;	// Shifts detected since startup
+};
+
+/// CPU frametime of a frame as the detector tests it: compositor render plus application CPU time
+float getTransitionCpuTime(const vr::Compositor_FrameTiming &frame);
+
+/// Feeds one ingested frame, returns true if a shift was detected
+bool updateTransitionFrame(TransitionDetector &detector, const vr::Compositor_FrameTiming &frame);
+
+/// Feeds the frametimes of a frame presented at compositor time timeS, returns true if a shift was detected
+bool updateTransitionTimes(TransitionDetector &detector, float gpuTime, float cpuTime, double timeS);
+
+/// Feeds a GPU utilization sample taken at compositor time timeS, returns true if a shift was detected
+bool updateTransitionUsage(TransitionDetector &detector, float gpuUsage, double timeS);
+
+/// Forgets the learned regime (keeping the thresholds), e.g. after changing the resolution ourselves
+void resetTransitionBaseline(TransitionDetector &detector);
+
+/// Whether adjustments should stay frozen at compositor time nowS
+bool isInTransition(TransitionDetector &detector, double nowS, int holdMs, int maxHoldMs);
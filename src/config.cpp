@@ -0,0 +1,48 @@
+#include "config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Latest published config
+static std::atomic<const Config *> currentConfig{nullptr};
+// Config the reader is using, a hazard pointer so the publisher doesn't free it under the reader
+static std::atomic<const Config *> readerConfig{nullptr};
+
+// Configs replaced by a newer one, freed once the reader let go of them
+static std::mutex retiredMutex;
+static std::vector<const Config *> retiredConfigs;
+
+void publishConfig(const Config &config)
+{
+	const Config *previous = currentConfig.exchange(new Config(config));
+	if (!previous)
+		return;
+
+	std::lock_guard<std::mutex> lock(retiredMutex);
+	retiredConfigs.push_back(previous);
+	const Config *inUse = readerConfig.load();
+	retiredConfigs.erase(std::remove_if(retiredConfigs.begin(), retiredConfigs.end(), [inUse](const Config *retired)
+										{
+											if (retired == inUse)
+												return false;
+											delete retired;
+											return true; }),
+						 retiredConfigs.end());
+}
+
+const Config &acquireConfig()
+{
+	// Announce the config we're about to use, and make sure it wasn't replaced (and maybe freed) meanwhile
+	const Config *config = currentConfig.load();
+	while (true)
+	{
+		readerConfig.store(config);
+		const Config *latest = currentConfig.load();
+		if (latest == config)
+			break;
+		config = latest;
+	}
+	return *config;
+}
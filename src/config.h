@@ -0,0 +1,115 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+/// Settings overridden for one app, raw ini values by key
+using AppProfile = std::map<std::string, std::string>;
+
+/// Whether the current app's profile turns adjustment on or off
+enum class AppEnabled
+{
+	Default, // Follow the app lists
+	Disabled,
+	Enabled
+};
+
+struct AppMatcher;
+
+/**
+ * Every setting of the app. Defaults and ranges are in settingsSchema.
+ * The GUI edits a draft and publishes copies of it; the controller reads
+ * the published copy, which never changes once published.
+ */
+struct Config
+{
+	// Startup
+	bool autoStart;
+	int minimizeOnStart;
+	int languageIndex;
+	// General
+	int resChangeDelayMs;
+	bool adaptiveResChangeDelay;
+	int resChangeDelayMinMs;
+	int resChangeDelayMaxMs;
+	int dataAverageMs;
+	int dataAverageHalfLifeMs;
+	int robustEstimator;
+	bool externalResChangeCompatibility;
+	bool traceEnabled;
+	bool frameTraceEnabled;
+	std::set<std::string> blacklistAppsSet;
+	bool whitelistEnabled;
+	std::set<std::string> whitelistAppsSet;
+	// Resolution
+	int initialRes;
+	int minRes;
+	int maxRes;
+	int resIncreaseThreshold;
+	int resDecreaseThreshold;
+	int resIncreaseThresholdFPS;
+	int resDecreaseThresholdFPS;
+	int resIncreaseMin;
+	int resDecreaseMin;
+	int resIncreaseScale;
+	int resDecreaseScale;
+	float minCpuTimeThreshold;
+	bool resetOnThreshold;
+	bool pauseOnLoading;
+	bool transitionDetection;
+	int transitionHoldMs;
+	bool jitterLimitEnabled;
+	float jitterThresholdMs;
+	bool renderTargetSnap;
+	int renderTargetTile;
+	bool hysteresisEnabled;
+	int increaseConfidence;
+	int decreaseConfidence;
+	int probeDwellMs;
+	int cooldownMs;
+	// Reprojection
+	bool alwaysReproject;
+	bool preferReprojection;
+	bool ignoreCpuTime;
+	bool reprojectionReasonAware;
+	bool subtractCompositorGpu;
+	bool refreshRateEnabled;
+	int refreshRateResFloor;
+	int refreshRateDwellMs;
+	// CPU
+	bool cpuMonitorEnabled;
+	int cpuBoundThreshold;
+	// VRAM
+	bool vramMonitorEnabled;
+	bool vramOnlyMode;
+	int vramTarget;
+	int vramLimit;
+	bool vramForecastEnabled;
+	int vramForecastSeconds;
+	// GPU usage
+	bool GPUusageEnabled;
+	int GPUusageLimit;
+	int GPUusageTarget;
+	// RAM
+	bool ramMonitorEnabled;
+	int ramLimit;
+
+	// Overrides layered over the settings above, by app key
+	std::map<std::string, AppProfile> appProfiles;
+
+	// Set when publishing: the current app's enabled override and the compiled app lists
+	AppEnabled profileEnabled;
+	std::shared_ptr<const AppMatcher> blacklistMatcher;
+	std::shared_ptr<const AppMatcher> whitelistMatcher;
+};
+
+/// Publishes a copy of config for the controller, replacing the previous one
+void publishConfig(const Config &config);
+
+/**
+ * Returns the latest published config without locking. It stays valid until
+ * the next call, so call it once per tick. Only one thread (the controller) may read.
+ */
+const Config &acquireConfig();
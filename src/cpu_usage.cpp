@@ -0,0 +1,131 @@
+#include "cpu_usage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <TlHelp32.h>
+#else
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#endif
+
+// CPU time (in ns) of each thread at the previous sample
+static std::unordered_map<uint64_t, uint64_t> lastThreadTimes;
+static uint32_t lastProcessId = 0;
+static std::chrono::steady_clock::time_point lastSampleTime;
+
+/// Reads the CPU time (user + kernel, in ns) of every thread of processId
+static bool readThreadTimes(uint32_t processId, std::unordered_map<uint64_t, uint64_t> &threadTimes)
+{
+#ifdef _WIN32
+	HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+	if (snapshot == INVALID_HANDLE_VALUE)
+		return false;
+
+	THREADENTRY32 entry;
+	entry.dwSize = sizeof(THREADENTRY32);
+	for (BOOL ok = Thread32First(snapshot, &entry); ok; ok = Thread32Next(snapshot, &entry))
+	{
+		if (entry.th32OwnerProcessID != processId)
+			continue;
+
+		HANDLE thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry.th32ThreadID);
+		if (!thread)
+			continue;
+
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if (GetThreadTimes(thread, &creationTime, &exitTime, &kernelTime, &userTime))
+		{
+			uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+			uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+			threadTimes[entry.th32ThreadID] = (kernel + user) * 100; // 100ns units
+		}
+		CloseHandle(thread);
+	}
+	CloseHandle(snapshot);
+#else
+	static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+
+	std::error_code ec;
+	std::filesystem::directory_iterator tasks("/proc/" + std::to_string(processId) + "/task", ec);
+	if (ec)
+		return false;
+
+	for (const auto &task : tasks)
+	{
+		FILE *file = fopen((task.path() / "stat").c_str(), "r");
+		if (!file)
+			continue;
+
+		char buffer[1024];
+		size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+		fclose(file);
+		buffer[length] = '\0';
+
+		// The thread name can contain spaces and parentheses, so start after the last ')'
+		char *fields = strrchr(buffer, ')');
+		if (!fields)
+			continue;
+
+		// Fields after the name start at 3 (state); utime and stime are 14 and 15
+		unsigned long long utime = 0, stime = 0;
+		if (sscanf(fields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2)
+			continue;
+
+		uint64_t threadId = std::strtoull(task.path().filename().c_str(), nullptr, 10);
+		threadTimes[threadId] = (utime + stime) * 1000000000ull / ticksPerSecond;
+	}
+#endif
+	return !threadTimes.empty();
+}
+
+void sampleSceneCpuUsage(uint32_t processId, SceneCpuUsage &usage)
+{
+	auto now = std::chrono::steady_clock::now();
+
+	std::unordered_map<uint64_t, uint64_t> threadTimes;
+	if (!processId || !readThreadTimes(processId, threadTimes))
+	{
+		usage = SceneCpuUsage();
+		lastThreadTimes.clear();
+		lastProcessId = 0;
+		return;
+	}
+
+	// Only compare samples of the same process
+	bool comparable = processId == lastProcessId && !lastThreadTimes.empty();
+	double elapsedNs = std::chrono::duration<double, std::nano>(now - lastSampleTime).count();
+
+	usage.processId = processId;
+	usage.threadCount = (int)threadTimes.size();
+	usage.valid = comparable && elapsedNs > 0;
+
+	if (usage.valid)
+	{
+		float busiest = 0;
+		float total = 0;
+		for (const auto &[threadId, cpuTime] : threadTimes)
+		{
+			auto last = lastThreadTimes.find(threadId);
+			if (last == lastThreadTimes.end() || cpuTime < last->second)
+				continue; // New thread, no delta yet
+
+			float percent = (float)((cpuTime - last->second) / elapsedNs * 100.0);
+			busiest = std::max(busiest, percent);
+			total += percent;
+		}
+		usage.busiestThreadPercent = std::min(busiest, 100.0f);
+		usage.totalPercent = total;
+	}
+
+	lastThreadTimes = std::move(threadTimes);
+	lastProcessId = processId;
+	lastSampleTime = now;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Per-thread CPU usage of the current scene application.
+ * Percentages are of a single logical core, so a saturated
+ * render thread reads ~100% no matter how many cores there are.
+ */
+struct SceneCpuUsage
+{
+	bool valid = false;				 // False until two samples of the same process were taken
+	uint32_t processId = 0;			 // Process the sample belongs to
+	int threadCount = 0;			 // Threads seen in the last sample
+	float busiestThreadPercent = 0;	 // CPU usage of the busiest thread
+	float totalPercent = 0;			 // Sum of all threads
+};
+
+/**
+ * Samples the CPU time of every thread of processId and updates usage with
+ * the usage since the previous call. Resets itself when processId changes.
+ * Linux reads /proc/<pid>/task/<tid>/stat, Windows uses GetThreadTimes.
+ */
+void sampleSceneCpuUsage(uint32_t processId, SceneCpuUsage &usage);
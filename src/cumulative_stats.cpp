@@ -0,0 +1,95 @@
+#include "cumulative_stats.h"
+
+void updateCumulativeStats(CumulativeStatsTracker &tracker, long long nowMs, CumulativeStatsRates &rates)
+{
+	vr::Compositor_CumulativeStats stats = {};
+	vr::VRCompositor()->GetCumulativeStats(&stats, sizeof(vr::Compositor_CumulativeStats));
+	diffCumulativeStats(tracker, stats, nowMs, rates);
+}
+
+/// Growth of a counter, flagging reset if it went down (it would wrap around otherwise)
+template <typename T>
+static T counterDelta(T current, T previous, bool &reset)
+{
+	if (current < previous)
+	{
+		reset = true;
+		return 0;
+	}
+	return current - previous;
+}
+
+void diffCumulativeStats(CumulativeStatsTracker &tracker, const vr::Compositor_CumulativeStats &stats, long long nowMs, CumulativeStatsRates &rates)
+{
+	const vr::Compositor_CumulativeStats &previous = tracker.previous;
+	rates = CumulativeStatsRates();
+
+	// The counters restart for each scene application
+	if (tracker.hasPrevious && stats.m_nPid == previous.m_nPid && nowMs > tracker.previousTimeMs)
+	{
+		bool reset = false;
+		rates.presents = counterDelta(stats.m_nNumFramePresents, previous.m_nNumFramePresents, reset);
+		rates.dropped = counterDelta(stats.m_nNumDroppedFrames, previous.m_nNumDroppedFrames, reset);
+		rates.reprojected = counterDelta(stats.m_nNumReprojectedFrames, previous.m_nNumReprojectedFrames, reset);
+		rates.startupPresents = counterDelta(stats.m_nNumFramePresentsOnStartup, previous.m_nNumFramePresentsOnStartup, reset);
+		rates.startupDropped = counterDelta(stats.m_nNumDroppedFramesOnStartup, previous.m_nNumDroppedFramesOnStartup, reset);
+		rates.startupReprojected = counterDelta(stats.m_nNumReprojectedFramesOnStartup, previous.m_nNumReprojectedFramesOnStartup, reset);
+		rates.loading = counterDelta(stats.m_nNumFramePresentsLoading, previous.m_nNumFramePresentsLoading, reset);
+		rates.loadingDropped = counterDelta(stats.m_nNumDroppedFramesLoading, previous.m_nNumDroppedFramesLoading, reset);
+		rates.loadingReprojected = counterDelta(stats.m_nNumReprojectedFramesLoading, previous.m_nNumReprojectedFramesLoading, reset);
+		rates.loadingStarts = counterDelta(stats.m_nNumLoading, previous.m_nNumLoading, reset);
+		rates.timedOut = counterDelta(stats.m_nNumFramePresentsTimedOut, previous.m_nNumFramePresentsTimedOut, reset);
+		rates.timedOutDropped = counterDelta(stats.m_nNumDroppedFramesTimedOut, previous.m_nNumDroppedFramesTimedOut, reset);
+		rates.timedOutReprojected = counterDelta(stats.m_nNumReprojectedFramesTimedOut, previous.m_nNumReprojectedFramesTimedOut, reset);
+		rates.timedOutStarts = counterDelta(stats.m_nNumTimedOut, previous.m_nNumTimedOut, reset);
+		rates.submits = counterDelta(stats.m_nNumFrameSubmits, previous.m_nNumFrameSubmits, reset);
+		rates.submitsWithDepth = counterDelta(stats.m_nNumFramesWithDepth, previous.m_nNumFramesWithDepth, reset);
+		double compositorCpuMs = counterDelta(stats.m_flSumCompositorCPUTimeMS, previous.m_flSumCompositorCPUTimeMS, reset);
+		double compositorGpuMs = counterDelta(stats.m_flSumCompositorGPUTimeMS, previous.m_flSumCompositorGPUTimeMS, reset);
+		double targetFrameMs = counterDelta(stats.m_flSumTargetFrameTimeMS, previous.m_flSumTargetFrameTimeMS, reset);
+		double applicationCpuMs = counterDelta(stats.m_flSumApplicationCPUTimeMS, previous.m_flSumApplicationCPUTimeMS, reset);
+		double applicationGpuMs = counterDelta(stats.m_flSumApplicationGPUTimeMS, previous.m_flSumApplicationGPUTimeMS, reset);
+
+		// Reset without the application changing, this interval can't be compared
+		if (reset)
+			rates = CumulativeStatsRates();
+		else
+		{
+			rates.valid = true;
+			rates.seconds = (nowMs - tracker.previousTimeMs) / 1000.0f;
+
+			rates.presentsPerSecond = rates.presents / rates.seconds;
+			rates.droppedPerSecond = rates.dropped / rates.seconds;
+			rates.reprojectedPerSecond = rates.reprojected / rates.seconds;
+			rates.startupPresentsPerSecond = rates.startupPresents / rates.seconds;
+			rates.startupDroppedPerSecond = rates.startupDropped / rates.seconds;
+			rates.startupReprojectedPerSecond = rates.startupReprojected / rates.seconds;
+			rates.loadingPerSecond = rates.loading / rates.seconds;
+			rates.loadingDroppedPerSecond = rates.loadingDropped / rates.seconds;
+			rates.loadingReprojectedPerSecond = rates.loadingReprojected / rates.seconds;
+			rates.timedOutPerSecond = rates.timedOut / rates.seconds;
+			rates.timedOutDroppedPerSecond = rates.timedOutDropped / rates.seconds;
+			rates.timedOutReprojectedPerSecond = rates.timedOutReprojected / rates.seconds;
+			rates.submitsPerSecond = rates.submits / rates.seconds;
+			rates.submitsWithDepthPerSecond = rates.submitsWithDepth / rates.seconds;
+
+			if (rates.submits > 0)
+			{
+				rates.compositorCpuMs = (float)(compositorCpuMs / rates.submits);
+				rates.compositorGpuMs = (float)(compositorGpuMs / rates.submits);
+				rates.targetFrameMs = (float)(targetFrameMs / rates.submits);
+				rates.applicationCpuMs = (float)(applicationCpuMs / rates.submits);
+				rates.applicationGpuMs = (float)(applicationGpuMs / rates.submits);
+			}
+		}
+	}
+
+	tracker.previous = stats;
+	tracker.previousTimeMs = nowMs;
+	tracker.hasPrevious = true;
+}
+
+bool isLoading(const CumulativeStatsRates &rates)
+{
+	return rates.valid && (rates.loading > 0 || rates.loadingStarts > 0);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <openvr.h>
+
+/// Compositor_CumulativeStats counters diffed between two ticks
+struct CumulativeStatsRates
+{
+	bool valid = false; // False on the first tick, when the scene application changed or a counter was reset
+	float seconds = 0;	// Length of the interval
+
+	// Counts over the interval
+	uint32_t presents = 0;
+	uint32_t dropped = 0;
+	uint32_t reprojected = 0;
+	uint32_t startupPresents = 0; // Frames presented while the application was starting
+	uint32_t startupDropped = 0;
+	uint32_t startupReprojected = 0;
+	uint32_t loading = 0; // Frames presented while the application was loading
+	uint32_t loadingDropped = 0;
+	uint32_t loadingReprojected = 0;
+	uint32_t loadingStarts = 0; // Times the application started loading
+	uint32_t timedOut = 0;		// Frames presented while the application timed out
+	uint32_t timedOutDropped = 0;
+	uint32_t timedOutReprojected = 0;
+	uint32_t timedOutStarts = 0; // Times the application started timing out
+	uint32_t submits = 0;		 // Frames submitted by the application
+	uint32_t submitsWithDepth = 0;
+
+	// Per second
+	float presentsPerSecond = 0;
+	float droppedPerSecond = 0;
+	float reprojectedPerSecond = 0;
+	float startupPresentsPerSecond = 0;
+	float startupDroppedPerSecond = 0;
+	float startupReprojectedPerSecond = 0;
+	float loadingPerSecond = 0;
+	float loadingDroppedPerSecond = 0;
+	float loadingReprojectedPerSecond = 0;
+	float timedOutPerSecond = 0;
+	float timedOutDroppedPerSecond = 0;
+	float timedOutReprojectedPerSecond = 0;
+	float submitsPerSecond = 0;
+	float submitsWithDepthPerSecond = 0;
+
+	// Means per submitted frame over the interval, 0 without submits
+	float compositorCpuMs = 0;
+	float compositorGpuMs = 0;
+	float targetFrameMs = 0;
+	float applicationCpuMs = 0;
+	float applicationGpuMs = 0;
+};
+
+struct CumulativeStatsTracker
+{
+	vr::Compositor_CumulativeStats previous = {};
+	long long previousTimeMs = 0;
+	bool hasPrevious = false;
+};
+
+/// Fetches the compositor's cumulative stats and computes the rates since the previous call
+void updateCumulativeStats(CumulativeStatsTracker &tracker, long long nowMs, CumulativeStatsRates &rates);
+
+/// Computes the rates between the previous stats of tracker and stats, then keeps stats as the new previous
+void diffCumulativeStats(CumulativeStatsTracker &tracker, const vr::Compositor_CumulativeStats &stats, long long nowMs, CumulativeStatsRates &rates);
+
+/// Whether the application was loading at some point during the interval
+bool isLoading(const CumulativeStatsRates &rates);
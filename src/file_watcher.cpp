@@ -0,0 +1,238 @@
+#include "file_watcher.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Time without events before the file is considered written, editors often write in several steps
+static constexpr const int settleMs = 100;
+
+static std::thread watcherThread;
+static std::filesystem::path watchedFile;
+static std::mutex changeMutex;
+static bool changed = false;
+static std::string changedContents;
+
+#ifdef _WIN32
+static HANDLE directoryHandle = INVALID_HANDLE_VALUE;
+static HANDLE stopEvent = nullptr;
+#else
+static int inotifyFd = -1;
+static int stopPipe[2] = {-1, -1};
+#endif
+
+static bool readFile(const std::filesystem::path &path, std::string &contents)
+{
+	FILE *file = fopen(path.string().c_str(), "rb");
+	if (!file)
+		return false;
+
+	contents.clear();
+	char buffer[4096];
+	size_t length;
+	while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		contents.append(buffer, length);
+	fclose(file);
+	return true;
+}
+
+static void publishChange()
+{
+	std::string contents;
+	if (!readFile(watchedFile, contents))
+		return; // Deleted or being replaced, the next event will tell
+
+	std::lock_guard<std::mutex> lock(changeMutex);
+	changedContents = std::move(contents);
+	changed = true;
+}
+
+#ifdef _WIN32
+static void watcherLoop()
+{
+	OVERLAPPED overlapped = {};
+	overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!overlapped.hEvent)
+		return;
+	HANDLE handles[2] = {stopEvent, overlapped.hEvent};
+	alignas(DWORD) char buffer[4096];
+	std::wstring fileName = watchedFile.filename().wstring();
+	bool pending = false;
+	bool reading = false;
+
+	while (true)
+	{
+		if (!reading)
+		{
+			ResetEvent(overlapped.hEvent);
+			if (!ReadDirectoryChangesW(directoryHandle, buffer, sizeof(buffer), FALSE,
+									   FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr))
+				break;
+			reading = true;
+		}
+
+		DWORD wait = WaitForMultipleObjects(2, handles, FALSE, pending ? settleMs : INFINITE);
+		if (wait == WAIT_TIMEOUT)
+		{
+			// Quiet for a while, the file is written
+			publishChange();
+			pending = false;
+			continue;
+		}
+		if (wait != WAIT_OBJECT_0 + 1)
+			break;
+
+		reading = false;
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(directoryHandle, &overlapped, &bytes, FALSE))
+			break;
+		if (bytes == 0)
+		{
+			// The buffer overflowed, assume our file was among the changes
+			pending = true;
+			continue;
+		}
+
+		for (char *entry = buffer;;)
+		{
+			auto *info = reinterpret_cast<FILE_NOTIFY_INFORMATION *>(entry);
+			std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+			if (CompareStringOrdinal(name.c_str(), (int)name.size(), fileName.c_str(), (int)fileName.size(), TRUE) == CSTR_EQUAL)
+				pending = true;
+			if (!info->NextEntryOffset)
+				break;
+			entry += info->NextEntryOffset;
+		}
+	}
+
+	if (reading)
+	{
+		DWORD bytes = 0;
+		CancelIo(directoryHandle);
+		GetOverlappedResult(directoryHandle, &overlapped, &bytes, TRUE);
+	}
+	CloseHandle(overlapped.hEvent);
+}
+#else
+static void watcherLoop()
+{
+	alignas(inotify_event) char buffer[4096];
+	std::string fileName = watchedFile.filename().string();
+	bool pending = false;
+
+	while (true)
+	{
+		pollfd fds[2] = {{stopPipe[0], POLLIN, 0}, {inotifyFd, POLLIN, 0}};
+		int ready = poll(fds, 2, pending ? settleMs : -1);
+		if (ready < 0)
+			break;
+		if (fds[0].revents)
+			break;
+		if (ready == 0)
+		{
+			// Quiet for a while, the file is written
+			publishChange();
+			pending = false;
+			continue;
+		}
+
+		ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+		for (char *entry = buffer; length > 0 && entry < buffer + length;)
+		{
+			auto *event = reinterpret_cast<inotify_event *>(entry);
+			if ((event->mask & IN_Q_OVERFLOW) || (event->len && fileName == event->name))
+				pending = true;
+			entry += sizeof(inotify_event) + event->len;
+		}
+	}
+}
+#endif
+
+bool startFileWatcher(const std::string &path)
+{
+	stopFileWatcher();
+
+	std::error_code ec;
+	watchedFile = std::filesystem::absolute(path, ec);
+	if (ec)
+		return false;
+	std::filesystem::path directory = watchedFile.parent_path();
+
+#ifdef _WIN32
+	directoryHandle = CreateFileW(directory.wstring().c_str(), FILE_LIST_DIRECTORY,
+								  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+								  OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (directoryHandle == INVALID_HANDLE_VALUE)
+		return false;
+	stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!stopEvent)
+	{
+		CloseHandle(directoryHandle);
+		directoryHandle = INVALID_HANDLE_VALUE;
+		return false;
+	}
+#else
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+		return false;
+	if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0 || pipe(stopPipe) < 0)
+	{
+		close(inotifyFd);
+		inotifyFd = -1;
+		return false;
+	}
+#endif
+
+	watcherThread = std::thread(watcherLoop);
+	return true;
+}
+
+bool takeFileChange(std::string &contents)
+{
+	std::lock_guard<std::mutex> lock(changeMutex);
+	if (!changed)
+		return false;
+	contents = std::move(changedContents);
+	changed = false;
+	return true;
+}
+
+void stopFileWatcher()
+{
+	if (!watcherThread.joinable())
+		return;
+
+#ifdef _WIN32
+	SetEvent(stopEvent);
+	watcherThread.join();
+	CloseHandle(directoryHandle);
+	CloseHandle(stopEvent);
+	directoryHandle = INVALID_HANDLE_VALUE;
+	stopEvent = nullptr;
+#else
+	char stop = 1;
+	if (write(stopPipe[1], &stop, 1) < 0)
+	{
+		// Closing the write end wakes poll() on the read end too
+		close(stopPipe[1]);
+		stopPipe[1] = -1;
+	}
+	watcherThread.join();
+	close(inotifyFd);
+	close(stopPipe[0]);
+	if (stopPipe[1] >= 0)
+		close(stopPipe[1]);
+	inotifyFd = -1;
+	stopPipe[0] = stopPipe[1] = -1;
+#endif
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+/**
+ * Watches one file for changes on a background thread, using inotify on Linux
+ * and ReadDirectoryChangesW on Windows (no polling). The directory is watched
+ * rather than the file so replacing it through a rename is seen too.
+ * Once the changes settle the file is read on the watcher thread.
+ */
+
+/// Starts watching path (relative to the working directory or absolute), false if it can't be watched
+bool startFileWatcher(const std::string &path);
+
+/// If the file changed since the last call, gets its new contents and returns true
+bool takeFileChange(std::string &contents);
+
+void stopFileWatcher();
@@ -0,0 +1,160 @@
+#include "frame_columns.h"
+
+#include <algorithm>
+#include <cstring>
+
+// SSE2 is always there on x64
+#if defined(__SSE2__) || defined(_M_X64)
+#define FRAME_COLUMNS_SSE
+#include <emmintrin.h>
+#endif
+
+// Histogram copies filled in turn, so consecutive samples in the same bucket don't wait on each other
+static constexpr const int histogramCopies = 4;
+
+void resizeFrameColumns(FrameColumns &columns, int capacity)
+{
+	capacity = std::max(capacity, 1);
+	if (capacity == columns.capacity)
+		return;
+
+	int kept = std::min(columns.size, capacity);
+	for (std::vector<float> &column : columns.columns)
+	{
+		std::vector<float> resized(capacity * 2);
+		if (kept > 0)
+			std::copy(column.begin() + columns.end - kept, column.begin() + columns.end, resized.begin());
+		column.swap(resized);
+	}
+	columns.capacity = capacity;
+	columns.end = kept;
+	columns.size = kept;
+}
+
+void appendFrameColumns(FrameColumns &columns, const vr::Compositor_FrameTiming &frame)
+{
+	if (columns.capacity == 0)
+		resizeFrameColumns(columns, 1);
+
+	// Out of room, move the newest frames back to the start
+	if (columns.end == columns.capacity * 2)
+	{
+		int kept = columns.capacity - 1;
+		for (std::vector<float> &column : columns.columns)
+			std::memmove(column.data(), column.data() + columns.end - kept, kept * sizeof(float));
+		columns.end = kept;
+	}
+
+	float applicationCpu = frame.m_flNewFrameReadyMs - frame.m_flNewPosesReadyMs;
+	float values[(int)FrameColumn::Count];
+	values[(int)FrameColumn::GpuTime] = frame.m_flTotalRenderGpuMs;
+	values[(int)FrameColumn::CpuTime] = frame.m_flCompositorRenderCpuMs + applicationCpu;
+	values[(int)FrameColumn::Presents] = (float)std::max((int)frame.m_nNumFramePresents, 1);
+	values[(int)FrameColumn::PreSubmitGpu] = frame.m_flPreSubmitGpuMs;
+	values[(int)FrameColumn::PostSubmitGpu] = frame.m_flPostSubmitGpuMs;
+	values[(int)FrameColumn::CompositorRenderGpu] = frame.m_flCompositorRenderGpuMs;
+	values[(int)FrameColumn::ApplicationCpu] = applicationCpu;
+	values[(int)FrameColumn::CompositorRenderCpu] = frame.m_flCompositorRenderCpuMs;
+	values[(int)FrameColumn::CompositorIdleCpu] = frame.m_flCompositorIdleCpuMs;
+	values[(int)FrameColumn::WaitForPresentCpu] = frame.m_flWaitForPresentCpuMs;
+	values[(int)FrameColumn::SubmitFrame] = frame.m_flSubmitFrameMs;
+
+	for (int i = 0; i < (int)FrameColumn::Count; i++)
+		columns.columns[i][columns.end] = values[i];
+	columns.end++;
+	columns.size = std::min(columns.size + 1, columns.capacity);
+}
+
+const float *getFrameColumn(const FrameColumns &columns, FrameColumn column, int frames)
+{
+	return columns.columns[(int)column].data() + columns.end - std::min(frames, columns.size);
+}
+
+static void reduceColumn(const float *values, int count, float histogramMax, ColumnStats &stats)
+{
+	stats = ColumnStats();
+	if (count <= 0)
+		return;
+
+	// Sums are taken relative to the first value to keep the variance accurate in floats
+	float shift = values[0];
+	float totalSum = 0;
+	float totalSquares = 0;
+	stats.min = shift;
+	stats.max = shift;
+
+	int i = 0;
+#ifdef FRAME_COLUMNS_SSE
+	// Two sets of accumulators, 8 values per iteration
+	__m128 shifts = _mm_set1_ps(shift);
+	__m128 sum[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+	__m128 squares[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+	__m128 low[2] = {shifts, shifts};
+	__m128 high[2] = {shifts, shifts};
+	for (; i + 8 <= count; i += 8)
+	{
+		for (int set = 0; set < 2; set++)
+		{
+			__m128 value = _mm_loadu_ps(values + i + set * 4);
+			__m128 shifted = _mm_sub_ps(value, shifts);
+			sum[set] = _mm_add_ps(sum[set], shifted);
+			squares[set] = _mm_add_ps(squares[set], _mm_mul_ps(shifted, shifted));
+			low[set] = _mm_min_ps(low[set], value);
+			high[set] = _mm_max_ps(high[set], value);
+		}
+	}
+
+	float lanes[4][4];
+	_mm_storeu_ps(lanes[0], _mm_add_ps(sum[0], sum[1]));
+	_mm_storeu_ps(lanes[1], _mm_add_ps(squares[0], squares[1]));
+	_mm_storeu_ps(lanes[2], _mm_min_ps(low[0], low[1]));
+	_mm_storeu_ps(lanes[3], _mm_max_ps(high[0], high[1]));
+	for (int lane = 0; lane < 4; lane++)
+	{
+		totalSum += lanes[0][lane];
+		totalSquares += lanes[1][lane];
+		stats.min = std::min(stats.min, lanes[2][lane]);
+		stats.max = std::max(stats.max, lanes[3][lane]);
+	}
+#endif
+	for (; i < count; i++)
+	{
+		float shifted = values[i] - shift;
+		totalSum += shifted;
+		totalSquares += shifted * shifted;
+		stats.min = std::min(stats.min, values[i]);
+		stats.max = std::max(stats.max, values[i]);
+	}
+
+	float meanShifted = totalSum / count;
+	stats.mean = shift + meanShifted;
+	stats.variance = std::max(totalSquares / count - meanShifted * meanShifted, 0.0f);
+
+	// Bucketing doesn't vectorise, but the column is still in cache
+	if (histogramMax > 0)
+	{
+		int histograms[histogramCopies][columnHistogramBuckets] = {};
+		float bucketsPerMs = columnHistogramBuckets / histogramMax;
+		float lastBucket = columnHistogramBuckets - 1;
+		for (i = 0; i < count; i++)
+		{
+			float bucket = values[i] * bucketsPerMs;
+			bucket = bucket < 0 ? 0 : (bucket > lastBucket ? lastBucket : bucket);
+			histograms[i % histogramCopies][(int)bucket]++;
+		}
+		for (int copy = 0; copy < histogramCopies; copy++)
+			for (int bucket = 0; bucket < columnHistogramBuckets; bucket++)
+				stats.histogram[bucket] += histograms[copy][bucket];
+	}
+}
+
+void reduceFrameColumns(const FrameColumns &columns, int frames, float histogramMax, ColumnStats *stats)
+{
+	int count = std::min(frames, columns.size);
+	for (int column = 0; column < (int)FrameColumn::Count; column++)
+	{
+		// Only the frametimes get a histogram
+		bool frametime = column == (int)FrameColumn::GpuTime || column == (int)FrameColumn::CpuTime;
+		reduceColumn(getFrameColumn(columns, (FrameColumn)column, count), count, frametime ? histogramMax : 0, stats[column]);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include <openvr.h>
+
+/// Per-frame values stored as contiguous columns, in ms (Presents in number of presents)
+enum class FrameColumn
+{
+	GpuTime,
+	CpuTime, // Compositor render + application CPU
+	Presents,
+	PreSubmitGpu,
+	PostSubmitGpu,
+	CompositorRenderGpu,
+	ApplicationCpu,
+	CompositorRenderCpu,
+	CompositorIdleCpu,
+	WaitForPresentCpu,
+	SubmitFrame,
+	Count
+};
+
+static constexpr const int columnHistogramBuckets = 16;
+
+/**
+ * Structure-of-arrays copy of the frame history, filled while ingesting.
+ * Each column holds twice the capacity and is shifted back when full,
+ * so the newest frames are always contiguous (oldest first).
+ */
+struct FrameColumns
+{
+	std::vector<float> columns[(int)FrameColumn::Count];
+	int capacity = 0;
+	int end = 0;  // One past the newest frame
+	int size = 0; // Frames available, up to capacity
+};
+
+/// Statistics of one column over a window
+struct ColumnStats
+{
+	float mean = 0;
+	float variance = 0;
+	float min = 0;
+	float max = 0;
+	int histogram[columnHistogramBuckets] = {}; // Buckets over [0, histogramMax), the last one also counts values above
+};
+
+/// Sets the capacity, keeping the newest frames
+void resizeFrameColumns(FrameColumns &columns, int capacity);
+
+void appendFrameColumns(FrameColumns &columns, const vr::Compositor_FrameTiming &frame);
+
+/// The newest frames values of column, oldest first (frames must not exceed columns.size)
+const float *getFrameColumn(const FrameColumns &columns, FrameColumn column, int frames);
+
+/**
+ * Reduces every column over the newest frames in one pass per column, stats must hold FrameColumn::Count entries.
+ * Histograms are only filled for GpuTime and CpuTime.
+ */
+void reduceFrameColumns(const FrameColumns &columns, int frames, float histogramMax, ColumnStats *stats);
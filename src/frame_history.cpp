@@ -0,0 +1,124 @@
+#include "frame_history.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Max stored by OpenVR
+static constexpr const int compositorFrameCount = 128;
+
+void initFrameHistory(FrameHistory &history, int capacity)
+{
+	history.frames.assign(std::max(capacity, 1), vr::Compositor_FrameTiming());
+	history.start = 0;
+	history.size = 0;
+	history.lastFrameIndex = 0;
+	history.columns = FrameColumns();
+	resizeFrameColumns(history.columns, capacity);
+	history.polled.assign(compositorFrameCount, vr::Compositor_FrameTiming());
+	history.polledCount = 0;
+}
+
+void resizeFrameHistory(FrameHistory &history, int capacity)
+{
+	capacity = std::max(capacity, 1);
+	if (capacity == (int)history.frames.size())
+		return;
+
+	// Unroll the ring, oldest first
+	int kept = std::min(history.size, capacity);
+	std::vector<vr::Compositor_FrameTiming> frames(capacity);
+	for (int i = 0; i < kept; i++)
+		frames[i] = getHistoryFrame(history, kept - 1 - i);
+
+	history.frames.swap(frames);
+	history.start = 0;
+	history.size = kept;
+	resizeFrameColumns(history.columns, capacity);
+}
+
+int ingestFrames(FrameHistory &history, const vr::Compositor_FrameTiming *frames, int count)
+{
+	int capacity = (int)history.frames.size();
+	int added = 0;
+	for (int i = 0; i < count; i++)
+	{
+		// Frames come oldest first, skip the ones we already have
+		if (history.size > 0 && frames[i].m_nFrameIndex <= history.lastFrameIndex)
+			continue;
+
+		if (history.size < capacity)
+		{
+			history.frames[(history.start + history.size) % capacity] = frames[i];
+			history.size++;
+		}
+		else
+		{
+			// Full, overwrite the oldest frame
+			history.frames[history.start] = frames[i];
+			history.start = (history.start + 1) % capacity;
+		}
+		appendFrameColumns(history.columns, frames[i]);
+		history.lastFrameIndex = frames[i].m_nFrameIndex;
+		added++;
+	}
+	return added;
+}
+
+int pollFrameTimings(FrameHistory &history)
+{
+	history.polled[0].m_nSize = sizeof(vr::Compositor_FrameTiming);
+	history.polledCount = (int)vr::VRCompositor()->GetFrameTimings(history.polled.data(), (uint32_t)history.polled.size());
+	return ingestFrames(history, history.polled.data(), history.polledCount);
+}
+
+const vr::Compositor_FrameTiming &getHistoryFrame(const FrameHistory &history, int age)
+{
+	int capacity = (int)history.frames.size();
+	return history.frames[(history.start + history.size - 1 - age) % capacity];
+}
+
+int getWindowFrames(const FrameHistory &history, int windowMs)
+{
+	if (history.size == 0)
+		return 0;
+
+	double newestS = getHistoryFrame(history, 0).m_flSystemTimeInSeconds;
+	double windowS = windowMs / 1000.0;
+	int frames = 1;
+	while (frames < history.size && newestS - getHistoryFrame(history, frames).m_flSystemTimeInSeconds < windowS)
+		frames++;
+	return frames;
+}
+
+float getFrameWeight(const FrameHistory &history, int age, int halfLifeMs)
+{
+	if (halfLifeMs <= 0)
+		return 1;
+
+	double ageMs = (getHistoryFrame(history, 0).m_flSystemTimeInSeconds - getHistoryFrame(history, age).m_flSystemTimeInSeconds) * 1000.0;
+	return (float)std::exp2(-ageMs / halfLifeMs);
+}
+
+bool computeFrameRate(const FrameHistory &history, int windowFrames, FrameRateStats &stats)
+{
+	int frames = std::min(windowFrames, history.size);
+	stats = FrameRateStats();
+	if (frames < 2)
+		return false;
+
+	const vr::Compositor_FrameTiming &newest = getHistoryFrame(history, 0);
+	const vr::Compositor_FrameTiming &oldest = getHistoryFrame(history, frames - 1);
+	double spanS = newest.m_flSystemTimeInSeconds - oldest.m_flSystemTimeInSeconds;
+	if (spanS <= 0)
+		return false;
+
+	int presents = 0;
+	for (int age = 0; age < frames; age++)
+		presents += std::max((int)getHistoryFrame(history, age).m_nNumFramePresents, 1);
+
+	stats.frames = frames;
+	stats.meanIntervalMs = (float)(spanS * 1000.0 / (frames - 1));
+	stats.fps = (float)((frames - 1) / spanS);
+	stats.presentsPerFrame = (float)presents / frames;
+	return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <openvr.h>
+
+#include "frame_columns.h"
+
+/**
+ * Frames pulled from the compositor, each ingested exactly once
+ * (OpenVR only keeps the last 128 and we poll more often than that).
+ */
+struct FrameHistory
+{
+	std::vector<vr::Compositor_FrameTiming> frames; // Ring buffer
+	int start = 0;								   // Index of the oldest frame
+	int size = 0;								   // Number of frames stored
+	uint32_t lastFrameIndex = 0;				   // Newest frame ingested
+	FrameColumns columns;						   // The same frames as float columns
+
+	// Buffer for GetFrameTimings, holding the frames of the last poll
+	std::vector<vr::Compositor_FrameTiming> polled;
+	int polledCount = 0;
+};
+
+/// Frame rate over a window of ingested frames, from the compositor's timestamps
+struct FrameRateStats
+{
+	int frames = 0;				  // Frames in the window
+	float fps = 0;				  // Application frames per second
+	float meanIntervalMs = 0;	  // Mean time between two application frames
+	float presentsPerFrame = 0;	  // Mean number of times each frame was presented
+};
+
+void initFrameHistory(FrameHistory &history, int capacity);
+
+/// Changes how many frames are kept, keeping the newest ones
+void resizeFrameHistory(FrameHistory &history, int capacity);
+
+/// Adds the frames newer than the last ingested one, returns how many were added
+int ingestFrames(FrameHistory &history, const vr::Compositor_FrameTiming *frames, int count);
+
+/// Fetches the compositor's frame timings and ingests the new ones, returns how many were added
+int pollFrameTimings(FrameHistory &history);
+
+/// Returns the frame ingested age frames ago (0 = newest)
+const vr::Compositor_FrameTiming &getHistoryFrame(const FrameHistory &history, int age);
+
+/// Number of newest frames rendered within windowMs of the newest one (at least 1 if there are any)
+int getWindowFrames(const FrameHistory &history, int windowMs);
+
+/// Weight of the frame age frames old for an exponentially weighted average with the given half-life (1 if halfLifeMs <= 0)
+float getFrameWeight(const FrameHistory &history, int age, int halfLifeMs);
+
+/// Frame rate over the newest windowFrames frames, false if there isn't enough data yet
+bool computeFrameRate(const FrameHistory &history, int windowFrames, FrameRateStats &stats);
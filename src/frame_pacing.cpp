@@ -0,0 +1,38 @@
+#include "frame_pacing.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool computeFramePacing(const FrameHistory &history, int windowFrames, float vsyncMs, FramePacingStats &stats)
+{
+	int frames = std::min(windowFrames, history.size);
+	stats = FramePacingStats();
+	if (frames < 3 || vsyncMs <= 0)
+		return false;
+
+	double sum = 0;
+	double sumSquares = 0;
+	double changes = 0;
+	double previousIntervalMs = -1;
+	for (int age = frames - 2; age >= 0; age--)
+	{
+		double intervalMs = (getHistoryFrame(history, age).m_flSystemTimeInSeconds - getHistoryFrame(history, age + 1).m_flSystemTimeInSeconds) * 1000.0;
+		sum += intervalMs;
+		sumSquares += intervalMs * intervalMs;
+		if (previousIntervalMs >= 0)
+			changes += std::fabs(intervalMs - previousIntervalMs);
+		previousIntervalMs = intervalMs;
+
+		// An interval of 3 vsyncs means 2 were missed
+		int missed = (int)std::lround(intervalMs / vsyncMs) - 1;
+		stats.maxMissedVsyncs = std::max(stats.maxMissedVsyncs, missed);
+	}
+
+	stats.intervals = frames - 1;
+	double mean = sum / stats.intervals;
+	stats.intervalMeanMs = (float)mean;
+	stats.intervalStdDevMs = (float)std::sqrt(std::max(sumSquares / stats.intervals - mean * mean, 0.0));
+	if (mean > 0)
+		stats.judder = (float)(changes / (stats.intervals - 1) / mean * 100.0);
+	return true;
+}
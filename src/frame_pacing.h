@@ -0,0 +1,19 @@
+#pragma once
+
+#include "frame_history.h"
+
+/**
+ * How evenly frames were delivered over a window, from the compositor's timestamps.
+ * The average FPS can look fine while intervals alternate between 8 and 14 ms.
+ */
+struct FramePacingStats
+{
+	int intervals = 0;		  // Frame intervals in the window
+	float intervalMeanMs = 0;
+	float intervalStdDevMs = 0; // Jitter
+	int maxMissedVsyncs = 0;	// Most vsyncs missed in a row between two frames
+	float judder = 0;			// Mean change between consecutive intervals, in % of the mean interval
+};
+
+/// Frame pacing over the newest windowFrames frames, vsyncMs being the display's refresh interval
+bool computeFramePacing(const FrameHistory &history, int windowFrames, float vsyncMs, FramePacingStats &stats);
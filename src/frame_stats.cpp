@@ -0,0 +1,44 @@
+#include "frame_stats.h"
+
+void setFrameStages(const ColumnStats *stats, int frames, FrameStageBudget &budget)
+{
+	budget.frames = frames;
+	budget.preSubmitGpu = stats[(int)FrameColumn::PreSubmitGpu].mean;
+	budget.postSubmitGpu = stats[(int)FrameColumn::PostSubmitGpu].mean;
+	budget.compositorRenderGpu = stats[(int)FrameColumn::CompositorRenderGpu].mean;
+	budget.totalRenderGpu = stats[(int)FrameColumn::GpuTime].mean;
+	budget.applicationCpu = stats[(int)FrameColumn::ApplicationCpu].mean;
+	budget.compositorRenderCpu = stats[(int)FrameColumn::CompositorRenderCpu].mean;
+	budget.compositorIdleCpu = stats[(int)FrameColumn::CompositorIdleCpu].mean;
+	budget.waitForPresentCpu = stats[(int)FrameColumn::WaitForPresentCpu].mean;
+	budget.submitFrame = stats[(int)FrameColumn::SubmitFrame].mean;
+}
+
+void countReprojectionReasons(const vr::Compositor_FrameTiming &frame, ReprojectionStats &stats)
+{
+	uint32_t flags = frame.m_nReprojectionFlags;
+
+	stats.frames++;
+	if (frame.m_nNumFramePresents > 1)
+		stats.reprojected++;
+	if (flags & vr::VRCompositor_ReprojectionReason_Cpu)
+		stats.cpu++;
+	if (flags & vr::VRCompositor_ReprojectionReason_Gpu)
+		stats.gpu++;
+	if (flags & vr::VRCompositor_ReprojectionAsync)
+		stats.async++;
+	if (flags & vr::VRCompositor_ReprojectionMotion)
+		stats.motion++;
+	if (flags & vr::VRCompositor_PredictionMask)
+		stats.predicted++;
+	if (flags & vr::VRCompositor_ThrottleMask)
+		stats.throttled++;
+}
+
+bool isReprojectionGpuBound(const ReprojectionStats &stats)
+{
+	// No reprojection: nothing says the GPU isn't the problem
+	if (stats.reprojected == 0)
+		return true;
+	return stats.gpu > 0 && stats.gpu >= stats.cpu;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <openvr.h>
+
+#include "frame_columns.h"
+
+/// Why frames were reprojected over an averaging window, from m_nReprojectionFlags
+struct ReprojectionStats
+{
+	int frames = 0;		 // Frames counted
+	int reprojected = 0; // Frames presented more than once
+	int cpu = 0;		 // Reprojected because the application's CPU work was late
+	int gpu = 0;		 // Reprojected because the application's GPU work was late
+	int async = 0;		 // Asynchronous reprojection was active
+	int motion = 0;		 // Motion smoothing was triggered
+	int predicted = 0;	 // The runtime predicted more than one frame ahead
+	int throttled = 0;	 // The compositor was throttling the application
+};
+
+/// Average time spent in each stage of a frame over an averaging window, in ms
+struct FrameStageBudget
+{
+	int frames = 0;
+	// GPU
+	float preSubmitGpu = 0;		   // Application work before Submit
+	float postSubmitGpu = 0;	   // Application work after Submit
+	float compositorRenderGpu = 0; // Compositor (distortion, reprojection, motion smoothing...)
+	float totalRenderGpu = 0;	   // Whole frame, including idle gaps
+	// CPU
+	float applicationCpu = 0;	   // From new poses to the new frame being ready
+	float compositorRenderCpu = 0; // Compositor render thread
+	float compositorIdleCpu = 0;   // Compositor waiting for the application
+	float waitForPresentCpu = 0;   // Compositor waiting for the GPU to present
+	float submitFrame = 0;		   // Time spent in Submit
+};
+
+/// Fills budget from the column statistics of a window of frames (see reduceFrameColumns)
+void setFrameStages(const ColumnStats *stats, int frames, FrameStageBudget &budget);
+
+/// Adds the reprojection flags of frame to stats
+void countReprojectionReasons(const vr::Compositor_FrameTiming &frame, ReprojectionStats &stats);
+
+/// Whether reprojection in stats is caused by the GPU, i.e. lowering the resolution could help
+bool isReprojectionGpuBound(const ReprojectionStats &stats);
@@ -53,7 +53,6 @@ enum class GpuType
 
 
 
-extern bool vramMonitorEnabled;
 extern float vramUsed; // Assume we always have free VRAM by default
 HMODULE nvmlLibrary;
 nvmlDevice_t nvmlDevice;
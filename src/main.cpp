@@ -4,7 +4,9 @@
 #include <thread>
 #include <cstdlib>
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <iostream>
 
 // OpenVR to interact with VR
 #include <openvr.h>
@@ -21,6 +23,26 @@
 #endif
 
 #include "get_info.h"
+#include "app_matcher.h"
+#include "app_profiles.h"
+#include "change_point.h"
+#include "config.h"
+#include "cpu_usage.h"
+#include "cumulative_stats.h"
+#include "file_watcher.h"
+#include "frame_history.h"
+#include "frame_pacing.h"
+#include "frame_stats.h"
+#include "res_change_cost.h"
+#include "refresh_rate.h"
+#include "render_target.h"
+#include "res_state.h"
+#include "robust_stats.h"
+#include "settings_schema.h"
+#include "settings_writer.h"
+#include "telemetry_history.h"
+#include "trace.h"
+#include "vram_forecast.h"
 
 // Loading and saving .ini configuration file
 #include "SimpleIni.h"
@@ -61,75 +83,172 @@ static constexpr const char *version = "v1.2.1";
 
 static constexpr const char *iconPath = "icon.png";
 
+static constexpr const char *tracePath = "trace.csv";
+static constexpr const char *frameTracePath = "frame_trace.csv";
+
+// Longest the loop sleeps between controller ticks, also how often new telemetry can redraw the GUI
 static constexpr const std::chrono::milliseconds refreshIntervalBackground = 167ms; // 6fps
-static constexpr const std::chrono::milliseconds refreshIntervalFocused = 33ms;		// 30fps
+// Fastest the GUI redraws, while it's being used
+static constexpr const std::chrono::milliseconds refreshIntervalFocused = 33ms; // 30fps
+// How long the GUI keeps redrawing after input, for hover states, tooltips and clicks to settle
+static constexpr const std::chrono::milliseconds inputRedrawLinger = 1000ms;
+
+// Highest frame rate the averaging window is sized for
+static constexpr const int maxHistoryFps = 240;
+// Smallest frametime excess over the median logged as a spike
+static constexpr const float minSpikeMs = 2.0f;
+// Latest spikes listed in the diagnostics
+static constexpr const size_t shownSpikes = 3;
+// Longest a scene transition can freeze adjustments
+static constexpr const int transitionMaxHoldMs = 30000;
+// Settings are written once they stopped changing for this long
+static constexpr const int settingsWriteDebounceMs = 500;
+// Interval between two points of the history graphs, and how far back they go
+static constexpr const int telemetrySampleMs = 250;
+static constexpr const int telemetryHistoryMinutes = 10;
 
 static constexpr const int mainWindowWidth = 350;
-static constexpr const int mainWindowHeight = 400;
+static constexpr const int mainWindowHeight = 460;
 
 
 
 GLFWwindow *glfwWindow;
 
 bool trayQuit = false;
+
+// The GUI redraws at the focused rate until then, pushed back by input
+std::chrono::steady_clock::time_point redrawUntil;
+
+void requestRedraw()
+{
+	redrawUntil = std::chrono::steady_clock::now() + inputRedrawLinger;
+}
 bool settingFlag = false;
 
 #pragma region Config
-#pragma region Default settings
-// Initialization
-bool autoStart = 1;
-int minimizeOnStart = 0;
-int languageIndex = 0;
-// General
-int resChangeDelayMs = 3000;
-int dataAverageSamples = 128;
-bool externalResChangeCompatibility = false;
-std::string blacklistApps = "steam.app.620980 steam.app.658920 steam.app.2177750 steam.app.2177760"; // Beat Saber and HL2VR
-std::set<std::string> blacklistAppsSet = {"steam.app.620980", "steam.app.658920", "steam.app.2177750", "steam.app.2177760"};
-bool whitelistEnabled = false;
-std::string whitelistApps = "";
-std::set<std::string> whitelistAppsSet = {};
-// Resolution
-int initialRes = 100;
-int minRes = 70;
-int maxRes = 200;
-int resIncreaseThreshold = 80;
-int resDecreaseThreshold = 88;
-int resIncreaseThresholdFPS = 60;
-int resDecreaseThresholdFPS = 50;
-int GPUusageTarget = 95;
-int GPUusageLimit = 100;
-bool GPUusageEnabled = true;
-int resIncreaseMin = 3;
-int resDecreaseMin = 5;
-int resIncreaseScale = 140;
-int resDecreaseScale = 140;
-float minCpuTimeThreshold = 0.6f;
-bool resetOnThreshold = true;
-// Reprojection
-bool alwaysReproject = false;
-bool preferReprojection = false;
-bool ignoreCpuTime = false;
-// VRAM
-int vramTarget = 80;
-int vramLimit = 90;
-bool vramMonitorEnabled = true;
-bool vramOnlyMode = false;
+#pragma region Settings
+// Settings being edited in the GUI, published to the controller when they change
+Config draftConfig;
+// App lists being edited, newline-delimited
+std::string blacklistApps;
+std::string whitelistApps;
+
+// Monitored
 float vramTotalGB = 0;
 bool GPUEnabled = true;
 float vramUsedGB = 0;
 float vramUsed = 0; // Assume we always have free VRAM by default
 int gpuUsage = 0;
-
-// RAM
 float ramUsedGB = 0;
 float ramTotalGB = 0;
-bool ramMonitorEnabled = false;
-int ramLimit = 90; 
 float ramUsed = 0;
-
 #pragma endregion
 
+/// Every setting saved in settings.ini: section, key, member of Config, default, range, GUI step and translation keys
+static constexpr SettingDesc settingsSchema[] = {
+	// Startup
+	boolSetting("Startup", "autoStart", &Config::autoStart, true, Str::Start_with_SteamVR, Str::Tooltip_start_with_SteamVR),
+	intSetting("Startup", "minimizeOnStart", &Config::minimizeOnStart, 0, 0, 2),
+	intSetting("Startup", "languageIndex", &Config::languageIndex, 0, 0, 63), // English, the known catalogs, then the others by name
+	// General
+	intSetting("General", "resChangeDelayMs", &Config::resChangeDelayMs, 3000, 100, 60000, 100, Str::Resolution_change_delay_ms, Str::Tooltip_resolution_change_delay_ms),
+	boolSetting("General", "adaptiveResChangeDelay", &Config::adaptiveResChangeDelay, true, Str::Adaptive_res_change_delay, Str::Tooltip_adaptive_res_change_delay),
+	intSetting("General", "resChangeDelayMinMs", &Config::resChangeDelayMinMs, 1000, 100, 60000, 100, Str::Res_change_delay_min_ms, Str::Tooltip_res_change_delay_min_ms),
+	intSetting("General", "resChangeDelayMaxMs", &Config::resChangeDelayMaxMs, 10000, 100, 60000, 100, Str::Res_change_delay_max_ms, Str::Tooltip_res_change_delay_max_ms),
+	intSetting("General", "dataAverageMs", &Config::dataAverageMs, 1500, 10, 10000, 100, Str::Data_average_ms, Str::Tooltip_data_average_ms),
+	intSetting("General", "dataAverageHalfLifeMs", &Config::dataAverageHalfLifeMs, 0, 0, 60000, 100, Str::Data_average_half_life_ms, Str::Tooltip_data_average_half_life_ms),
+	intSetting("General", "robustEstimator", &Config::robustEstimator, (int)RobustEstimator::MedianMad, 0, 2),
+	boolSetting("General", "externalResChangeCompatibility", &Config::externalResChangeCompatibility, false, Str::External_res_change_compatibility, Str::Tooltip_external_res_change_compatibility),
+	boolSetting("General", "traceEnabled", &Config::traceEnabled, false, Str::Trace_enabled, Str::Tooltip_trace_enabled),
+	boolSetting("General", "frameTraceEnabled", &Config::frameTraceEnabled, false, Str::Frame_trace_enabled, Str::Tooltip_frame_trace_enabled),
+	appListSetting("General", "disabledApps", &Config::blacklistAppsSet, "steam.app.620980 steam.app.658920 steam.app.2177750 steam.app.2177760"),
+	boolSetting("General", "whitelistEnabled", &Config::whitelistEnabled, false, Str::Enable_whitelist, Str::Tooltip_enable_whitelist),
+	appListSetting("General", "whitelistApps", &Config::whitelistAppsSet, ""),
+	// Resolution
+	intSetting("Resolution", "initialRes", &Config::initialRes, 100, 20, 500, 5, Str::Initial_resolution, Str::Tooltip_initial_resolution),
+	intSetting("Resolution", "minRes", &Config::minRes, 70, 20, 500, 5, Str::Minimum_resolution, Str::Tooltip_minimum_resolution),
+	intSetting("Resolution", "maxRes", &Config::maxRes, 200, 20, 500, 5, Str::Maximum_resolution, Str::Tooltip_maximum_resolution),
+	intSetting("Resolution", "resIncreaseThreshold", &Config::resIncreaseThreshold, 80, 0, 100),
+	intSetting("Resolution", "resDecreaseThreshold", &Config::resDecreaseThreshold, 88, 0, 100),
+	intSetting("Resolution", "resIncreaseThresholdFPS", &Config::resIncreaseThresholdFPS, 60, 10, 1000, 1, Str::Increase_threshold, Str::Tooltip_increase_threshold),
+	intSetting("Resolution", "resDecreaseThresholdFPS", &Config::resDecreaseThresholdFPS, 50, 10, 1000, 1, Str::Decrease_threshold, Str::Tooltip_decrease_threshold),
+	intSetting("Resolution", "resIncreaseMin", &Config::resIncreaseMin, 3, 0, 100, 1, Str::Increase_minimum, Str::Tooltip_increase_minimum),
+	intSetting("Resolution", "resDecreaseMin", &Config::resDecreaseMin, 5, 0, 100, 1, Str::Decrease_minimum, Str::Tooltip_decrease_minimum),
+	intSetting("Resolution", "resIncreaseScale", &Config::resIncreaseScale, 140, 0, 1000, 10, Str::Increase_scale, Str::Tooltip_increase_scale),
+	intSetting("Resolution", "resDecreaseScale", &Config::resDecreaseScale, 140, 0, 1000, 10, Str::Decrease_scale, Str::Tooltip_decrease_scale),
+	floatSetting("Resolution", "minCpuTimeThreshold", &Config::minCpuTimeThreshold, 0.6, 0, 100, 0.1, Str::Minimum_CPU_time_threshold, Str::Tooltip_minimum_CPU_time_threshold),
+	boolSetting("Resolution", "resetOnThreshold", &Config::resetOnThreshold, true, Str::Reset_on_CPU_time_threshold, Str::Tooltip_reset_on_CPU_time_threshold),
+	boolSetting("Resolution", "pauseOnLoading", &Config::pauseOnLoading, true, Str::Pause_on_loading, Str::Tooltip_pause_on_loading),
+	boolSetting("Resolution", "transitionDetection", &Config::transitionDetection, true, Str::Transition_detection, Str::Tooltip_transition_detection),
+	intSetting("Resolution", "transitionHoldMs", &Config::transitionHoldMs, 3000, 0, 30000, 500, Str::Transition_hold_ms, Str::Tooltip_transition_hold_ms),
+	boolSetting("Resolution", "jitterLimitEnabled", &Config::jitterLimitEnabled, false, Str::Jitter_limit_enabled, Str::Tooltip_jitter_limit_enabled),
+	floatSetting("Resolution", "jitterThresholdMs", &Config::jitterThresholdMs, 2.0, 0.1, 100, 0.1, Str::Jitter_threshold_ms, Str::Tooltip_jitter_threshold_ms),
+	boolSetting("Resolution", "renderTargetSnap", &Config::renderTargetSnap, false, Str::Render_target_snap, Str::Tooltip_render_target_snap),
+	intSetting("Resolution", "renderTargetTile", &Config::renderTargetTile, 32, 16, 64),
+	boolSetting("Resolution", "hysteresisEnabled", &Config::hysteresisEnabled, true, Str::Hysteresis_enabled, Str::Tooltip_hysteresis_enabled),
+	intSetting("Resolution", "increaseConfidence", &Config::increaseConfidence, 2, 1, 10, 1, Str::Increase_confidence, Str::Tooltip_increase_confidence),
+	intSetting("Resolution", "decreaseConfidence", &Config::decreaseConfidence, 1, 1, 10, 1, Str::Decrease_confidence, Str::Tooltip_decrease_confidence),
+	intSetting("Resolution", "probeDwellMs", &Config::probeDwellMs, 2000, 0, 60000, 500, Str::Probe_dwell_ms, Str::Tooltip_probe_dwell_ms),
+	intSetting("Resolution", "cooldownMs", &Config::cooldownMs, 15000, 0, 600000, 1000, Str::Cooldown_ms, Str::Tooltip_cooldown_ms),
+	// Reprojection
+	boolSetting("Reprojection", "alwaysReproject", &Config::alwaysReproject, false, Str::Always_reproject, Str::Tooltip_always_reproject),
+	boolSetting("Reprojection", "preferReprojection", &Config::preferReprojection, false, Str::Prefer_reprojection, Str::Tooltip_prefer_reprojection),
+	boolSetting("Reprojection", "ignoreCpuTime", &Config::ignoreCpuTime, false, Str::Ignore_CPU_time, Str::Tooltip_ignore_CPU_time),
+	boolSetting("Reprojection", "reprojectionReasonAware", &Config::reprojectionReasonAware, true, Str::Reprojection_reason_aware, Str::Tooltip_reprojection_reason_aware),
+	boolSetting("Reprojection", "subtractCompositorGpu", &Config::subtractCompositorGpu, false, Str::Subtract_compositor_GPU, Str::Tooltip_subtract_compositor_GPU),
+	boolSetting("Reprojection", "refreshRateEnabled", &Config::refreshRateEnabled, false, Str::Refresh_rate_enabled, Str::Tooltip_refresh_rate_enabled),
+	intSetting("Reprojection", "refreshRateResFloor", &Config::refreshRateResFloor, 100, 20, 500, 5, Str::Refresh_rate_res_floor, Str::Tooltip_refresh_rate_res_floor),
+	intSetting("Reprojection", "refreshRateDwellMs", &Config::refreshRateDwellMs, 20000, 0, 600000, 1000, Str::Refresh_rate_dwell_ms, Str::Tooltip_refresh_rate_dwell_ms),
+	// CPU
+	boolSetting("CPU", "cpuMonitorEnabled", &Config::cpuMonitorEnabled, true, Str::CPU_monitor_enabled, Str::Tooltip_cpu_monitor),
+	intSetting("CPU", "cpuBoundThreshold", &Config::cpuBoundThreshold, 90, 10, 100, 5, Str::CPU_bound_threshold, Str::Tooltip_cpu_bound_threshold),
+	// VRAM
+	boolSetting("VRAM", "vramMonitorEnabled", &Config::vramMonitorEnabled, true, Str::VRAM_monitor_enabled, Str::Tooltip_vram_monitor),
+	boolSetting("VRAM", "vramOnlyMode", &Config::vramOnlyMode, false, Str::VRAM_only_mode, Str::Tooltip_VRAM_only_mode),
+	intSetting("VRAM", "vramTarget", &Config::vramTarget, 80, 0, 100, 2, Str::VRAM_target, Str::Tooltip_vram_target),
+	intSetting("VRAM", "vramLimit", &Config::vramLimit, 90, 0, 100, 2, Str::VRAM_limit, Str::Tooltip_vram_limit),
+	boolSetting("VRAM", "vramForecastEnabled", &Config::vramForecastEnabled, true, Str::VRAM_forecast_enabled, Str::Tooltip_vram_forecast_enabled),
+	intSetting("VRAM", "vramForecastSeconds", &Config::vramForecastSeconds, 10, 1, 120, 1, Str::VRAM_forecast_seconds, Str::Tooltip_vram_forecast_seconds),
+	// GPUusage
+	boolSetting("GPUusage", "GPUusageEnabled", &Config::GPUusageEnabled, true, Str::GPU_usage_enabled, Str::Tooltip_GPU_usage_enabled),
+	intSetting("GPUusage", "GPUusageLimit", &Config::GPUusageLimit, 100, 10, 100, 2, Str::GPU_usage_limit, Str::Tooltip_GPU_usage_limit),
+	intSetting("GPUusage", "GPUusageTarget", &Config::GPUusageTarget, 95, 10, 100, 2, Str::GPU_usage_target, Str::Tooltip_GPU_usage_target),
+	// RAM
+	boolSetting("RAM", "ramMonitorEnabled", &Config::ramMonitorEnabled, false, Str::RAM_monitor_enabled, Str::Tooltip_ram_monitor),
+	intSetting("RAM", "ramLimit", &Config::ramLimit, 90, 0, 100, 2, Str::RAM_limit, Str::Tooltip_ram_limit),
+};
+
+// Hash of the settings last written to settings.ini, to skip saves that wouldn't change anything
+uint64_t savedSettingsHash = 0;
+// Hash of the settings as last loaded from or saved to settings.ini, the draft has unsaved changes when it differs
+uint64_t diskSettingsHash = 0;
+// Hashes of the contents we queued for settings.ini and haven't seen on disk yet, oldest first,
+// to tell our own writes from someone else's
+std::vector<size_t> queuedSettingsWrites;
+static constexpr const size_t maxQueuedSettingsWrites = 16;
+// Hash of the settings last published to the controller
+uint64_t publishedConfigHash = 0;
+// Scene app whose profile is layered over the published settings, resolved when the scene app changes
+std::string profileAppKey;
+uint32_t profileProcessId = 0;
+// Last compiled app lists, reused while the lists don't change so their cached matches are kept
+std::shared_ptr<const AppMatcher> blacklistMatcher;
+std::shared_ptr<const AppMatcher> whitelistMatcher;
+
+/// Publishes a copy of the draft with the current app's profile applied, if either changed since the last time
+void publishDraftConfig()
+{
+	uint64_t hash = hashSettings(settingsSchema, std::size(settingsSchema), draftConfig) ^ std::hash<std::string>{}(profileAppKey);
+	if (hash == publishedConfigHash)
+		return;
+	Config resolved = draftConfig;
+	resolveAppProfile(resolved, profileAppKey, settingsSchema, std::size(settingsSchema));
+	blacklistMatcher = resolved.blacklistMatcher = compileAppMatcher(resolved.blacklistAppsSet, blacklistMatcher);
+	whitelistMatcher = resolved.whitelistMatcher = compileAppMatcher(resolved.whitelistAppsSet, whitelistMatcher);
+	publishConfig(resolved);
+	publishedConfigHash = hash;
+}
+
 
 
 
@@ -149,158 +268,131 @@ std::set<std::string> multilineStringToSet(const std::string &val)
 
 
 
-/// Set to a space-delimited string
-std::string setToConfigString(std::set<std::string> &valSet)
+bool loadSettings()
 {
-	std::string result;
+	resetSettings(settingsSchema, std::size(settingsSchema), draftConfig);
 
-	for (std::string val : valSet)
-	{
-		result += (val + " ");
-	}
-	if (!result.empty())
+	// Get ini file
+	CSimpleIniA ini;
+	bool loaded = ini.LoadFile("settings.ini") >= 0;
+	int invalid = 0;
+	if (loaded)
 	{
-		// remove trailing space
-		result.pop_back();
+		invalid = parseSettings(ini, settingsSchema, std::size(settingsSchema), draftConfig);
+		parseAppProfiles(ini, draftConfig.appProfiles);
+
+		// Convert the old frame count, assuming 90 Hz
+		if (!ini.GetValue("General", "dataAverageMs") && ini.GetValue("General", "dataAverageSamples"))
+		{
+			draftConfig.dataAverageMs = std::clamp(std::atoi(ini.GetValue("General", "dataAverageSamples")) * 1000 / 90, 10, 10000);
+			invalid++;
+		}
 	}
 
-	return result;
+	// The app lists are edited one per line
+	blacklistApps = appListToString(draftConfig.blacklistAppsSet, '\n');
+	whitelistApps = appListToString(draftConfig.whitelistAppsSet, '\n');
+
+	// Rewrite the file on the next save if it had values we had to fix
+	diskSettingsHash = hashSettings(settingsSchema, std::size(settingsSchema), draftConfig);
+	savedSettingsHash = loaded && invalid == 0 ? diskSettingsHash : 0;
+	publishDraftConfig();
+	return loaded;
 }
 
-bool loadSettings()
+void saveSettings()
 {
-	// Get ini file
+	uint64_t hash = hashSettings(settingsSchema, std::size(settingsSchema), draftConfig);
+	if (hash == savedSettingsHash)
+		return;
+
 	CSimpleIniA ini;
-	SI_Error rc = ini.LoadFile("settings.ini");
-	if (rc < 0)
+	serializeSettings(ini, settingsSchema, std::size(settingsSchema), draftConfig);
+	serializeAppProfiles(ini, draftConfig.appProfiles);
+	std::string contents;
+	if (ini.Save(contents) < 0)
+		return;
+
+	// Save changes to disk in the background
+	if (queuedSettingsWrites.size() == maxQueuedSettingsWrites)
+		queuedSettingsWrites.erase(queuedSettingsWrites.begin());
+	queuedSettingsWrites.push_back(std::hash<std::string>()(contents));
+	queueSettingsWrite("settings.ini", std::move(contents));
+	savedSettingsHash = diskSettingsHash = hash;
+}
+
+/**
+ * Whether contents is one of our own saves reaching the disk. Saves queued before it were
+ * written before it or coalesced into it, so they're forgotten too.
+ */
+bool isOwnSettingsWrite(const std::string &contents)
+{
+	auto queued = std::find(queuedSettingsWrites.begin(), queuedSettingsWrites.end(), std::hash<std::string>()(contents));
+	if (queued == queuedSettingsWrites.end())
 		return false;
+	queuedSettingsWrites.erase(queuedSettingsWrites.begin(), queued + 1);
+	return true;
+}
 
-	try
-	{
-		// Startup
-		autoStart = std::stoi(ini.GetValue("Startup", "autoStart", std::to_string(autoStart).c_str()));
-		minimizeOnStart = std::stoi(ini.GetValue("Startup", "minimizeOnStart", std::to_string(minimizeOnStart).c_str()));
-		languageIndex = std::stoi(ini.GetValue("Startup", "languageIndex", std::to_string(languageIndex).c_str()));
-
-		// General
-		resChangeDelayMs = std::stoi(ini.GetValue("General", "resChangeDelayMs", std::to_string(resChangeDelayMs).c_str()));
-		dataAverageSamples = std::stoi(ini.GetValue("General", "dataAverageSamples", std::to_string(dataAverageSamples).c_str()));
-		externalResChangeCompatibility = std::stoi(ini.GetValue("General", "externalResChangeCompatibility", std::to_string(externalResChangeCompatibility).c_str()));
-		if (dataAverageSamples > 128)
-			dataAverageSamples = 128; // Max stored by OpenVR
-		// blacklist
-		blacklistApps = ini.GetValue("General", "disabledApps", blacklistApps.c_str());
-		std::replace(blacklistApps.begin(), blacklistApps.end(), ' ', '\n');
-		blacklistAppsSet = multilineStringToSet(blacklistApps);
-		// whitelist
-		whitelistEnabled = std::stoi(ini.GetValue("General", "whitelistEnabled", std::to_string(whitelistEnabled).c_str()));
-		whitelistApps = ini.GetValue("General", "whitelistApps", blacklistApps.c_str());
-		std::replace(whitelistApps.begin(), whitelistApps.end(), ' ', '\n');
-		whitelistAppsSet = multilineStringToSet(whitelistApps);
-
-		// Resolution
-		initialRes = std::stoi(ini.GetValue("Resolution", "initialRes", std::to_string(initialRes).c_str()));
-		minRes = std::stoi(ini.GetValue("Resolution", "minRes", std::to_string(minRes).c_str()));
-		maxRes = std::stoi(ini.GetValue("Resolution", "maxRes", std::to_string(maxRes).c_str()));
-		resIncreaseThreshold = std::stoi(ini.GetValue("Resolution", "resIncreaseThreshold", std::to_string(resIncreaseThreshold).c_str()));
-		resDecreaseThreshold = std::stoi(ini.GetValue("Resolution", "resDecreaseThreshold", std::to_string(resDecreaseThreshold).c_str()));
-		resIncreaseThresholdFPS = std::stoi(ini.GetValue("Resolution", "resIncreaseThresholdFPS", std::to_string(resIncreaseThresholdFPS).c_str()));
-		resDecreaseThresholdFPS = std::stoi(ini.GetValue("Resolution", "resDecreaseThresholdFPS", std::to_string(resDecreaseThresholdFPS).c_str()));
-		resIncreaseMin = std::stoi(ini.GetValue("Resolution", "resIncreaseMin", std::to_string(resIncreaseMin).c_str()));
-		resDecreaseMin = std::stoi(ini.GetValue("Resolution", "resDecreaseMin", std::to_string(resDecreaseMin).c_str()));
-		resIncreaseScale = std::stoi(ini.GetValue("Resolution", "resIncreaseScale", std::to_string(resIncreaseScale).c_str()));
-		resDecreaseScale = std::stoi(ini.GetValue("Resolution", "resDecreaseScale", std::to_string(resDecreaseScale).c_str()));
-		minCpuTimeThreshold = std::stof(ini.GetValue("Resolution", "minCpuTimeThreshold", std::to_string(minCpuTimeThreshold).c_str()));
-		resetOnThreshold = std::stoi(ini.GetValue("Resolution", "resetOnThreshold", std::to_string(resetOnThreshold).c_str()));
-
-		// Reprojection
-		alwaysReproject = std::stoi(ini.GetValue("Reprojection", "alwaysReproject", std::to_string(alwaysReproject).c_str()));
-		preferReprojection = std::stoi(ini.GetValue("Reprojection", "preferReprojection", std::to_string(preferReprojection).c_str()));
-		ignoreCpuTime = std::stoi(ini.GetValue("Reprojection", "ignoreCpuTime", std::to_string(ignoreCpuTime).c_str()));
-
-		// VRAM
-		vramMonitorEnabled = std::stoi(ini.GetValue("VRAM", "vramMonitorEnabled", std::to_string(vramMonitorEnabled).c_str()));
-		vramOnlyMode = std::stoi(ini.GetValue("VRAM", "vramOnlyMode", std::to_string(vramOnlyMode).c_str()));
-		vramTarget = std::stoi(ini.GetValue("VRAM", "vramTarget", std::to_string(vramTarget).c_str()));
-		vramLimit = std::stoi(ini.GetValue("VRAM", "vramLimit", std::to_string(vramLimit).c_str()));
-		// GPU usage percentage
-		GPUusageEnabled = std::stoi(ini.GetValue("GPUusage", "GPUusageEnabled", std::to_string(GPUusageEnabled).c_str()));
-		GPUusageLimit = std::stoi(ini.GetValue("GPUusage", "GPUusageLimit", std::to_string(GPUusageLimit).c_str()));
-		GPUusageTarget = std::stoi(ini.GetValue("GPUusage", "GPUusageTarget", std::to_string(GPUusageTarget).c_str()));
-		// RAM
-		ramMonitorEnabled = std::stoi(ini.GetValue("RAM", "ramMonitorEnabled", std::to_string(ramMonitorEnabled).c_str()));
-		ramLimit = std::stoi(ini.GetValue("RAM", "ramLimit", std::to_string(ramLimit).c_str()));
-
-
-		return true;
-	}
-	catch (...)
+/**
+ * Applies settings.ini after it was changed by something else while running (e.g. deployment tools).
+ * Settings that are missing or invalid keep their current value. Returns whether anything was applied.
+ * Ignored while the settings have unsaved changes, saving them replaces the file.
+ */
+bool reloadSettings(const std::string &contents)
+{
+	if (isOwnSettingsWrite(contents))
+		return false;
+	if (hashSettings(settingsSchema, std::size(settingsSchema), draftConfig) != diskSettingsHash)
 	{
+		std::cout << "settings.ini changed on disk while there are unsaved changes, keeping them." << std::endl;
 		return false;
 	}
-}
 
-void saveSettings()
-{
-	// Get ini file
 	CSimpleIniA ini;
+	if (ini.LoadData(contents) < 0)
+		return false;
 
-	// Startup
-	ini.SetValue("Startup", "autoStart", std::to_string(autoStart).c_str());
-	ini.SetValue("Startup", "minimizeOnStart", std::to_string(minimizeOnStart).c_str());
-	ini.SetValue("Startup", "languageIndex", std::to_string(languageIndex).c_str());
-
-	// General
-	ini.SetValue("General", "resChangeDelayMs", std::to_string(resChangeDelayMs).c_str());
-	ini.SetValue("General", "dataAverageSamples", std::to_string(dataAverageSamples).c_str());
-	ini.SetValue("General", "externalResChangeCompatibility", std::to_string(externalResChangeCompatibility).c_str());
-	ini.SetValue("General", "disabledApps", setToConfigString(blacklistAppsSet).c_str());
-	ini.SetValue("General", "whitelistEnabled", std::to_string(whitelistEnabled).c_str());
-	ini.SetValue("General", "whitelistApps", setToConfigString(whitelistAppsSet).c_str());
-
-	// Resolution
-	ini.SetValue("Resolution", "initialRes", std::to_string(initialRes).c_str());
-	ini.SetValue("Resolution", "minRes", std::to_string(minRes).c_str());
-	ini.SetValue("Resolution", "maxRes", std::to_string(maxRes).c_str());
-	ini.SetValue("Resolution", "resIncreaseThreshold", std::to_string(resIncreaseThreshold).c_str());
-	ini.SetValue("Resolution", "resDecreaseThreshold", std::to_string(resDecreaseThreshold).c_str());
-	ini.SetValue("Resolution", "resIncreaseThresholdFPS", std::to_string(resIncreaseThresholdFPS).c_str());
-	ini.SetValue("Resolution", "resDecreaseThresholdFPS", std::to_string(resDecreaseThresholdFPS).c_str());
-	ini.SetValue("Resolution", "resIncreaseMin", std::to_string(resIncreaseMin).c_str());
-	ini.SetValue("Resolution", "resDecreaseMin", std::to_string(resDecreaseMin).c_str());
-	ini.SetValue("Resolution", "resIncreaseScale", std::to_string(resIncreaseScale).c_str());
-	ini.SetValue("Resolution", "resDecreaseScale", std::to_string(resDecreaseScale).c_str());
-	ini.SetValue("Resolution", "minCpuTimeThreshold", std::to_string(minCpuTimeThreshold).c_str());
-	ini.SetValue("Resolution", "resetOnThreshold", std::to_string(resetOnThreshold).c_str());
-
-	// Reprojection
-	ini.SetValue("Reprojection", "alwaysReproject", std::to_string(alwaysReproject).c_str());
-	ini.SetValue("Reprojection", "preferReprojection", std::to_string(preferReprojection).c_str());
-	ini.SetValue("Reprojection", "ignoreCpuTime", std::to_string(ignoreCpuTime).c_str());
-
-	// VRAM
-	ini.SetValue("VRAM", "vramMonitorEnabled", std::to_string(vramMonitorEnabled).c_str());
-	ini.SetValue("VRAM", "vramOnlyMode", std::to_string(vramOnlyMode).c_str());
-	ini.SetValue("VRAM", "vramTarget", std::to_string(vramTarget).c_str());
-	ini.SetValue("VRAM", "vramLimit", std::to_string(vramLimit).c_str());
-	// GPU usage percentage
-	ini.SetValue("GPUusage", "GPUusageEnabled", std::to_string(GPUusageEnabled).c_str());
-	ini.SetValue("GPUusage", "GPUusageLimit", std::to_string(GPUusageLimit).c_str());
-	ini.SetValue("GPUusage", "GPUusageTarget", std::to_string(GPUusageTarget).c_str());
-	// RAM
-	ini.SetValue("RAM", "ramMonitorEnabled", std::to_string(ramMonitorEnabled).c_str());
-	ini.SetValue("RAM", "ramLimit", std::to_string(ramLimit).c_str());
-	// Save changes to disk
-	ini.SaveFile("settings.ini");
+	uint64_t previousHash = hashSettings(settingsSchema, std::size(settingsSchema), draftConfig);
+	int invalid = parseSettings(ini, settingsSchema, std::size(settingsSchema), draftConfig);
+	parseAppProfiles(ini, draftConfig.appProfiles);
+	blacklistApps = appListToString(draftConfig.blacklistAppsSet, '\n');
+	whitelistApps = appListToString(draftConfig.whitelistAppsSet, '\n');
+
+	uint64_t hash = hashSettings(settingsSchema, std::size(settingsSchema), draftConfig);
+	diskSettingsHash = hash;
+	savedSettingsHash = invalid == 0 ? hash : 0;
+	publishDraftConfig();
+	return hash != previousHash;
 }
 #pragma endregion
 
-long getCurrentTimeMillis()
+/// Milliseconds on a monotonic clock, only meaningful relative to another call
+long long getCurrentTimeMillis()
 {
-	auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
-	auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch);
+	auto sinceStart = std::chrono::steady_clock::now().time_since_epoch();
+	auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(sinceStart);
 	return millis.count();
 }
+
+/// Frames to keep so the averaging window fits at up to maxHistoryFps, and never less than OpenVR keeps
+int getFrameHistoryCapacity(const Config &config)
+{
+	return std::max(config.dataAverageMs * maxHistoryFps / 1000, 128) + 128;
+}
+
+/// Records in the frame trace that the transition detector forgot its baseline, at the newest frame
+void traceTransitionReset(const FrameHistory &frameHistory, bool transition)
+{
+	if (!isFrameTraceOpen())
+		return;
+	FrameTraceRow row;
+	row.timeS = frameHistory.size > 0 ? getHistoryFrame(frameHistory, 0).m_flSystemTimeInSeconds : 0;
+	row.event = FrameTraceEvent::Reset;
+	row.transition = transition;
+	writeFrameTraceRow(row);
+}
+
 /**
  * Returns the current VR application key (steam.app.000000)
  * or an empty string if no app is running.
@@ -320,24 +412,32 @@ std::string getCurrentApplicationKey()
 	return {applicationKey};
 }
 
-bool isApplicationBlacklisted(std::string appKey)
+// Match results of the controller loop, the only thread checking app keys
+static AppMatchCache blacklistMatches;
+static AppMatchCache whitelistMatches;
+
+/// Whether the published config's blacklist matches appKey (exact keys or patterns)
+bool isApplicationBlacklisted(const Config &config, const std::string &appKey)
 {
-	return appKey == "" || blacklistAppsSet.find(appKey) != blacklistAppsSet.end();
+	return appKey == "" || matchApp(blacklistMatches, config.blacklistMatcher, appKey);
 }
 
-bool isApplicationWhitelisted(std::string appKey)
+/// Whether the published config's whitelist matches appKey (exact keys or patterns)
+bool isApplicationWhitelisted(const Config &config, const std::string &appKey)
 {
-	return appKey != "" && whitelistAppsSet.find(appKey) != whitelistAppsSet.end();
+	return appKey != "" && matchApp(whitelistMatches, config.whitelistMatcher, appKey);
 }
 
-bool shouldAdjustResolution(std::string appKey, bool manualRes, float cpuTime)
+bool shouldAdjustResolution(const Config &config, const std::string &appKey, bool manualRes, float cpuTime)
 {
 	// Check if the SteamVR dashboard is open
 	bool inDashboard = vr::VROverlay()->IsDashboardVisible();
-	// Check that we're in a supported application
-	bool isCurrentAppSupported = !isApplicationBlacklisted(appKey) && (!whitelistEnabled || isApplicationWhitelisted(appKey));
+	// Check that we're in a supported application, the app's profile has the last word
+	bool isCurrentAppSupported = config.profileEnabled == AppEnabled::Default
+									 ? !isApplicationBlacklisted(config, appKey) && (!config.whitelistEnabled || isApplicationWhitelisted(config, appKey))
+									 : config.profileEnabled == AppEnabled::Enabled && appKey != "";
 	// Only adjust resolution if not in dashboard, in a supported application. user didn't pause res and cpu time isn't below threshold
-	return !inDashboard && isCurrentAppSupported && !manualRes && !(resetOnThreshold && cpuTime < minCpuTimeThreshold);
+	return !inDashboard && isCurrentAppSupported && !manualRes && !(config.resetOnThreshold && cpuTime < config.minCpuTimeThreshold);
 }
 
 void pushGrayButtonColour()
@@ -365,7 +465,7 @@ void pushGreenButtonColour()
 
 void printLine(std::string text, long duration)
 {
-	long startTime = getCurrentTimeMillis();
+	long long startTime = getCurrentTimeMillis();
 
 	while (getCurrentTimeMillis() < startTime + duration && !glfwWindowShouldClose(glfwWindow))
 	{
@@ -412,6 +512,95 @@ void cleanup()
 	glfwTerminate();
 }
 
+/**
+ * Draws a horizontal bar made of one segment per value, scaled so the full width is budget.
+ * Segments going over budget are clipped and the bar is outlined in red.
+ */
+void drawStackedBar(const float *values, const ImU32 *colours, int count, float budget)
+{
+	ImDrawList *drawList = ImGui::GetWindowDrawList();
+	ImVec2 start = ImGui::GetCursorScreenPos();
+	float width = ImGui::GetContentRegionAvail().x;
+	float height = ImGui::GetTextLineHeight();
+
+	float total = 0;
+	float x = start.x;
+	for (int i = 0; i < count; i++)
+	{
+		float segment = budget > 0 ? std::max(values[i], 0.0f) / budget * width : 0;
+		float end = std::min(x + segment, start.x + width);
+		drawList->AddRectFilled(ImVec2(x, start.y), ImVec2(end, start.y + height), colours[i]);
+		x = end;
+		total += values[i];
+	}
+	ImU32 outline = total > budget ? IM_COL32(220, 60, 60, 255) : IM_COL32(90, 90, 90, 255);
+	drawList->AddRect(start, ImVec2(start.x + width, start.y + height), outline);
+
+	ImGui::Dummy(ImVec2(width, height));
+}
+
+/**
+ * Draws the last spanMs of a telemetry field as one min/max bar per pixel column, scaled
+ * from 0 to the highest value, with a red line at target (none if NaN).
+ */
+void drawTelemetryGraph(const TelemetryRing &ring, float TelemetrySample::*field, long long nowMs, long long spanMs, float target, ImU32 colour)
+{
+	ImDrawList *drawList = ImGui::GetWindowDrawList();
+	ImVec2 start = ImGui::GetCursorScreenPos();
+	float width = ImGui::GetContentRegionAvail().x;
+	float height = 40;
+
+	static std::vector<float> mins;
+	static std::vector<float> maxs;
+	int columns = std::max((int)width, 1);
+	mins.resize(columns);
+	maxs.resize(columns);
+	downsampleTelemetry(ring, field, nowMs, spanMs, columns, mins.data(), maxs.data());
+
+	float top = std::isnan(target) ? 0 : target;
+	for (int i = 0; i < columns; i++)
+	{
+		if (!std::isnan(maxs[i]))
+			top = std::max(top, maxs[i]);
+	}
+	top = top > 0 ? top * 1.1f : 1;
+	auto toY = [&](float value)
+	{ return start.y + height - std::clamp(value / top, 0.0f, 1.0f) * height; };
+
+	drawList->AddRectFilled(start, ImVec2(start.x + width, start.y + height), IM_COL32(20, 20, 20, 255));
+	int previous = -1;
+	for (int i = 0; i < columns; i++)
+	{
+		if (std::isnan(mins[i]))
+			continue;
+		float x = start.x + i + 0.5f;
+		drawList->AddLine(ImVec2(x, toY(maxs[i]) - 0.5f), ImVec2(x, toY(mins[i]) + 0.5f), colour);
+		// Join the columns left empty when there are fewer samples than pixels
+		if (previous >= 0 && i - previous > 1)
+			drawList->AddLine(ImVec2(start.x + previous + 0.5f, toY((mins[previous] + maxs[previous]) / 2)), ImVec2(x, toY((mins[i] + maxs[i]) / 2)), colour);
+		previous = i;
+	}
+	if (!std::isnan(target))
+		drawList->AddLine(ImVec2(start.x, toY(target)), ImVec2(start.x + width, toY(target)), IM_COL32(220, 60, 60, 255));
+	drawList->AddRect(start, ImVec2(start.x + width, start.y + height), IM_COL32(90, 90, 90, 255));
+
+	ImGui::Dummy(ImVec2(width, height));
+}
+
+/// Coloured square followed by text, on the same line as the previous item unless it's the first
+void drawLegendItem(ImU32 colour, const char *text, bool first)
+{
+	if (!first)
+		ImGui::SameLine();
+	ImVec2 pos = ImGui::GetCursorScreenPos();
+	float size = ImGui::GetTextLineHeight() * 0.7f;
+	float offset = (ImGui::GetTextLineHeight() - size) / 2;
+	ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(pos.x, pos.y + offset), ImVec2(pos.x + size, pos.y + offset + size), colour);
+	ImGui::Dummy(ImVec2(size, size));
+	ImGui::SameLine(0, 4);
+	ImGui::TextUnformatted(text);
+}
+
 void addTooltip(const char *text)
 {
 	ImGui::SameLine();
@@ -425,6 +614,111 @@ void addTooltip(const char *text)
 	}
 }
 
+/// Draws the widget of a setting from settingsSchema with its tooltip, returns whether the value changed
+bool drawSetting(const char *key)
+{
+	const SettingDesc *setting = findSetting(settingsSchema, std::size(settingsSchema), key);
+	if (!setting || setting->label == Str::None)
+		return false;
+
+	bool changed = false;
+	const char *label = LanguageManager::getInstance().translate(setting->label);
+	switch (setting->type)
+	{
+	case SettingType::Bool:
+		changed = ImGui::Checkbox(label, &(draftConfig.*setting->boolValue));
+		break;
+	case SettingType::Int:
+		changed = ImGui::InputInt(label, &(draftConfig.*setting->intValue), (int)setting->step);
+		break;
+	case SettingType::Float:
+		changed = ImGui::InputFloat(label, &(draftConfig.*setting->floatValue), (float)setting->step);
+		break;
+	default:
+		break;
+	}
+	if (changed)
+		clampSetting(*setting, draftConfig);
+	addTooltip(LanguageManager::getInstance().translate(setting->tooltip));
+	return changed;
+}
+
+/// Draws the profile of the current scene app: whether it's enabled and the settings it overrides
+void drawAppProfileEditor()
+{
+	if (profileAppKey.empty())
+	{
+		ImGui::Text("%s", LanguageManager::getInstance().translate(Str::No_current_app));
+		return;
+	}
+	ImGui::Text("%s", profileAppKey.c_str());
+
+	AppProfile &profile = draftConfig.appProfiles[profileAppKey];
+
+	// Enabled overrides the whitelist and blacklist
+	auto enabled = profile.find(appProfileEnabledKey);
+	int enabledState = enabled == profile.end() ? 0 : enabled->second == "0" ? 1 : 2;
+	int previousEnabledState = enabledState;
+	ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Profile_default), &enabledState, 0);
+	ImGui::SameLine();
+	ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Profile_disabled), &enabledState, 1);
+	ImGui::SameLine();
+	ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Profile_enabled), &enabledState, 2);
+	addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_profile_enabled));
+	if (enabledState != previousEnabledState)
+	{
+		if (enabledState == 0)
+			profile.erase(appProfileEnabledKey);
+		else
+			profile[appProfileEnabledKey] = enabledState == 1 ? "0" : "1";
+	}
+
+	// Overrides, in red if they won't apply
+	std::string removedKey;
+	for (auto &[key, value] : profile)
+	{
+		if (key == appProfileEnabledKey)
+			continue;
+
+		const SettingDesc *setting = findSetting(settingsSchema, std::size(settingsSchema), key.c_str());
+		Config scratch{};
+		bool valid = setting && isSettingOverridable(*setting) && parseSetting(*setting, value.c_str(), scratch);
+
+		ImGui::PushID(key.c_str());
+		if (!valid)
+			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1, 0.4f, 0.4f, 1));
+		ImGui::SetNextItemWidth(120);
+		ImGui::InputText(key.c_str(), &value, ImGuiInputTextFlags_CharsNoBlank);
+		if (!valid)
+			ImGui::PopStyleColor();
+		if (setting && setting->tooltip != Str::None)
+			addTooltip(LanguageManager::getInstance().translate(setting->tooltip));
+		ImGui::SameLine();
+		if (ImGui::SmallButton(LanguageManager::getInstance().translate(Str::Remove)))
+			removedKey = key;
+		ImGui::PopID();
+	}
+	if (!removedKey.empty())
+		profile.erase(removedKey);
+
+	// Start new overrides from the global value
+	if (ImGui::BeginCombo(LanguageManager::getInstance().translate(Str::Add_override), nullptr))
+	{
+		for (const SettingDesc &setting : settingsSchema)
+		{
+			if (!isSettingOverridable(setting) || profile.count(setting.key))
+				continue;
+			if (ImGui::Selectable(setting.key))
+				profile[setting.key] = formatSetting(setting, draftConfig);
+		}
+		ImGui::EndCombo();
+	}
+	addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_add_override));
+
+	if (profile.empty())
+		draftConfig.appProfiles.erase(profileAppKey);
+}
+
 std::string executable_path;
 
 std::string get_executable_path()
@@ -494,6 +788,25 @@ int main(int argc, char *argv[])
 	ImGui::StyleColorsDark();
 	ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.03, 0.03, 0.03, 1));
 
+	// Redraw on input. Installed first so the ImGui backend chains to them
+	glfwSetCursorPosCallback(glfwWindow, [](GLFWwindow *, double, double)
+							 { requestRedraw(); });
+	glfwSetCursorEnterCallback(glfwWindow, [](GLFWwindow *, int)
+							   { requestRedraw(); });
+	glfwSetMouseButtonCallback(glfwWindow, [](GLFWwindow *, int, int, int)
+							   { requestRedraw(); });
+	glfwSetScrollCallback(glfwWindow, [](GLFWwindow *, double, double)
+						  { requestRedraw(); });
+	glfwSetKeyCallback(glfwWindow, [](GLFWwindow *, int, int, int, int)
+					   { requestRedraw(); });
+	glfwSetCharCallback(glfwWindow, [](GLFWwindow *, unsigned int)
+						{ requestRedraw(); });
+	glfwSetWindowFocusCallback(glfwWindow, [](GLFWwindow *, int)
+							   { requestRedraw(); });
+	// And when the window's contents were lost (uncovered, restored)
+	glfwSetWindowRefreshCallback(glfwWindow, [](GLFWwindow *)
+								 { requestRedraw(); });
+
 	// Setup Platform/Renderer backends
 	ImGui_ImplGlfw_InitForOpenGL(glfwWindow, true);
 #ifdef __EMSCRIPTEN__
@@ -528,24 +841,26 @@ int main(int argc, char *argv[])
 #pragma endregion
 
 	// Load settings from ini file
+	startSettingsWriter(settingsWriteDebounceMs);
 	if (!loadSettings()) {
-		std::replace(blacklistApps.begin(), blacklistApps.end(), ' ', '\n'); // Set blacklist newlines
-		saveSettings();														 // Restore settings
+		saveSettings(); // Restore settings
 	} else {
 		settingFlag = true;
 	}
+	if (!startFileWatcher("settings.ini"))
+		std::cout << "Failed to watch settings.ini, changes to it apply on restart." << std::endl;
 
-	setLanguage(languageIndex);
+	setLanguage(draftConfig.languageIndex);
 
 	// Set auto-start
-	int autoStartResult = handle_setup(autoStart);
+	int autoStartResult = handle_setup(draftConfig.autoStart);
 	if (autoStartResult != 0)
 		printLine(fmt::format("Error toggling auto-start ({}) ", autoStartResult), 6000l);
 
 	// Minimize or hide the window according to config
-	if (minimizeOnStart == 1) // Minimize
+	if (draftConfig.minimizeOnStart == 1) // Minimize
 		glfwIconifyWindow(glfwWindow);
-	else if (minimizeOnStart == 2) // Hide
+	else if (draftConfig.minimizeOnStart == 2) // Hide
 		glfwHideWindow(glfwWindow);
 
 	// Make sure we can set resolution ourselves (Custom instead of Auto)
@@ -554,13 +869,13 @@ int main(int argc, char *argv[])
 
 	// Set default resolution
 	vr::VRSettings()->SetFloat(vr::k_pch_SteamVR_Section,
-							   vr::k_pch_SteamVR_SupersampleScale_Float, initialRes / 100.0f);
+							   vr::k_pch_SteamVR_SupersampleScale_Float, draftConfig.initialRes / 100.0f);
 
 	initGetGPUInfo();
 #pragma endregion
 #if defined(_WIN32)
 	const char *hideToggleText = "Hide";
-	if (minimizeOnStart == 2)
+	if (draftConfig.minimizeOnStart == 2)
 	{
 		hideToggleText = "Show";
 	}
@@ -569,14 +884,14 @@ int main(int argc, char *argv[])
 		"icon.ico",
 		"OVR Dynamic Resolution",
 		[](tray *trayInstance)
-		{ trayInstance->menu->text = "Hide"; tray_update(trayInstance); glfwShowWindow(glfwWindow); },
+		{ trayInstance->menu->text = "Hide"; tray_update(trayInstance); glfwShowWindow(glfwWindow); glfwPostEmptyEvent(); },
 		new tray_menu_item[5]{
 			{hideToggleText, 0, 0, [](tray_menu_item *item)
 			 { if (item->text == "Hide") { item->text = "Show"; tray_update(tray_get_instance()); glfwHideWindow(glfwWindow); } 
-			   else { item->text = "Hide"; tray_update(tray_get_instance()); glfwShowWindow(glfwWindow); } }},
+			   else { item->text = "Hide"; tray_update(tray_get_instance()); glfwShowWindow(glfwWindow); glfwPostEmptyEvent(); } }},
 			{"-", 0, 0, nullptr},
 			{"Quit", 0, 0, [](tray_menu_item *item)
-			 { trayQuit = true; }},
+			 { trayQuit = true; glfwPostEmptyEvent(); }},
 			{nullptr, 0, 0, nullptr}}};
 
 	tray_init(&trayInstance);
@@ -586,8 +901,12 @@ int main(int argc, char *argv[])
 #endif // _WIN32
 
 	// Initialize loop variables
-	Compositor_FrameTiming *frameTiming = new vr::Compositor_FrameTiming[dataAverageSamples];
-	long lastChangeTime = getCurrentTimeMillis() - resChangeDelayMs - 1;
+	FrameHistory frameHistory;
+	initFrameHistory(frameHistory, getFrameHistoryCapacity(draftConfig));
+	int currentResChangeDelayMs = draftConfig.resChangeDelayMs;
+	float currentSettleMs = 0;
+	float currentSpikeMs = 0;
+	long long lastChangeTime = getCurrentTimeMillis() - draftConfig.resChangeDelayMs - 1;
 	bool adjustResolution = true;
 	bool openvrQuit = false;
 	bool manualRes = false;
@@ -596,28 +915,145 @@ int main(int argc, char *argv[])
 	float averageGpuTime = 0;
 	float averageCpuTime = 0;
 	float averageFrameShown = 0;
-	float newRes = initialRes;
+	float newRes = draftConfig.initialRes;
 	int targetFps = 0;
 	float targetFrametime = 0;
 	int hmdHz = 0;
 	float hmdFrametime = 0;
-	int currentFps = 0;
+	float currentFps = 0;
+	FramePacingStats framePacing;
+	VramForecast vramForecast;
+	RefreshRatePolicy refreshRatePolicy;
+	int previousHmdHz = 0;
+	int requestedHmdHz = 0;	 // Rate the refresh rate policy last switched to
+	int thresholdBaseHz = 0; // Rate the FPS thresholds of the settings apply to
+	float vramSecondsToLimit = -1;
+	float vramPerStepGB = 0;
+	bool jittery = false;
 	//float vramUsedGB = 0;
+	SceneCpuUsage sceneCpuUsage;
+	bool cpuBound = false;
+	ResStateMachine resStateMachine;
+	ReprojectionStats reprojectionStats;
+	FrameStageBudget frameStages;
+	CumulativeStatsTracker cumulativeStatsTracker;
+	CumulativeStatsRates cumulativeRates;
+	bool loading = false;
+	// Statistics of the averaging window
+	ColumnStats windowStats[(int)FrameColumn::Count];
+	float windowHistogramMaxMs = 0;
+	std::vector<float> windowWeights;
+	std::vector<float> robustScratch;
+	RobustAverage gpuTimeAverage;
+	RobustAverage cpuTimeAverage;
+	uint32_t lastSpikeCheckedFrame = 0;
+	int frameSpikes = 0;
+	struct FrameSpike
+	{
+		uint32_t frameIndex;
+		long long timeMs;
+		float gpuTime;
+		float cpuTime;
+	};
+	std::vector<FrameSpike> recentSpikes; // Newest first
+	TransitionDetector transitionDetector;
+	bool transition = false;
+	// History graphs
+	TelemetryRing telemetryRing;
+	initTelemetryRing(telemetryRing, telemetryHistoryMinutes * 60000 / telemetrySampleMs);
+	TelemetryAccumulator telemetryAccumulator;
+	TelemetrySample telemetrySample;
 
 	// GUI variables
 	bool showSettings = false;
-	bool prevAutoStart = autoStart;
-				vr::Compositor_CumulativeStats stats = {};
-			uint32_t previousFramePresents = 0;
-			vr::IVRCompositor* vrCompositor = vr::VRCompositor();
+	bool prevAutoStart = draftConfig.autoStart;
+	bool windowVisible = false;
+	bool guiActive = false; // Editing text or dragging, the GUI animates without input
+	bool telemetryChanged = true;
+	bool historyShown = false;
+	int historySpanMinutes = 5;
+	std::chrono::steady_clock::time_point lastRenderTime;
+	requestRedraw();
 	// event loop
 	while (!glfwWindowShouldClose(glfwWindow) && !openvrQuit && !trayQuit)
 	{
+		// Sleep until there's input, the next controller tick or the next GUI frame that's due
+		std::chrono::duration<double> waitTime = refreshIntervalBackground;
+		auto now = std::chrono::steady_clock::now();
+		if (windowVisible && (now < redrawUntil || guiActive))
+			waitTime = std::clamp<std::chrono::duration<double>>(lastRenderTime + refreshIntervalFocused - now, 0ms, refreshIntervalFocused);
+		glfwWaitEventsTimeout(waitTime.count());
+
 		// Get current time
-		long currentTime = getCurrentTimeMillis();
+		long long currentTime = getCurrentTimeMillis();
+
+		// Apply settings.ini changes made outside the app, between two iterations so nothing sees half of them
+		std::string changedSettings;
+		if (takeFileChange(changedSettings) && reloadSettings(changedSettings))
+		{
+			setLanguage(draftConfig.languageIndex);
+			if (prevAutoStart != draftConfig.autoStart)
+			{
+				handle_setup(draftConfig.autoStart);
+				prevAutoStart = draftConfig.autoStart;
+			}
+			requestRedraw();
+		}
+
+		// Switch to the profile of the scene app when it changes (retrying while its key is unknown), rather than looking it up every iteration
+		uint32_t sceneProcessId = vr::VRApplications()->GetCurrentSceneProcessId();
+		if (sceneProcessId != profileProcessId || (sceneProcessId && profileAppKey.empty()))
+		{
+			profileProcessId = sceneProcessId;
+			profileAppKey = getCurrentApplicationKey();
+			publishDraftConfig();
+			telemetryChanged = true;
+		}
+
+		// The settings for this iteration, they don't change under us even if the GUI publishes new ones
+		const Config &config = acquireConfig();
+
+		// Keep enough frames for the averaging window
+		resizeFrameHistory(frameHistory, getFrameHistoryCapacity(config));
+
+		// Ingest the frames rendered since the last loop
+		int newFrames = pollFrameTimings(frameHistory);
+		int newColumnFrames = std::min(newFrames, frameHistory.columns.size);
+		accumulateTelemetryFrames(telemetryAccumulator, getFrameColumn(frameHistory.columns, FrameColumn::GpuTime, newColumnFrames),
+								  getFrameColumn(frameHistory.columns, FrameColumn::CpuTime, newColumnFrames), newColumnFrames);
+
+		// Record what the transition detector sees, to replay it offline (bench/change_point_replay.cpp)
+		if (config.frameTraceEnabled && !isFrameTraceOpen())
+			openFrameTrace(frameTracePath);
+		else if (!config.frameTraceEnabled && isFrameTraceOpen())
+			closeFrameTrace();
+
+		// Follow the frames rendered since the last resolution change to measure how long it takes to settle
+		bool settling = isSettleMeasurementPending();
+		if (settling)
+			updateSettleMeasurement(frameHistory.polled.data(), frameHistory.polledCount);
+		// Otherwise look for shifts in frametimes caused by the scene changing (our own changes would trigger it too)
+		if (!settling || isFrameTraceOpen())
+			for (int age = std::min(newFrames, frameHistory.size) - 1; age >= 0; age--)
+			{
+				const vr::Compositor_FrameTiming &frame = getHistoryFrame(frameHistory, age);
+				bool changePoint = !settling && updateTransitionFrame(transitionDetector, frame);
+				if (isFrameTraceOpen())
+				{
+					FrameTraceRow row;
+					row.timeS = frame.m_flSystemTimeInSeconds;
+					row.frameIndex = frame.m_nFrameIndex;
+					row.gpuTime = frame.m_flTotalRenderGpuMs;
+					row.cpuTime = getTransitionCpuTime(frame);
+					row.settling = settling;
+					row.changePoint = changePoint;
+					row.transition = transition;
+					writeFrameTraceRow(row);
+				}
+			}
 
 		// Doesn't run every loop
-		if (currentTime - resChangeDelayMs > lastChangeTime)
+		if (currentTime - currentResChangeDelayMs > lastChangeTime)
 		{
 			//lastChangeTime = currentTime;
 
@@ -625,7 +1061,7 @@ int main(int argc, char *argv[])
 			float currentRes = vr::VRSettings()->GetFloat(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_SupersampleScale_Float) * 100.0f;
 
 			// Check for external resolution change compatibility
-			if (externalResChangeCompatibility && std::fabs(newRes - currentRes) > 0.001f && !manualRes)
+			if (config.externalResChangeCompatibility && std::fabs(newRes - currentRes) > 0.001f && !manualRes)
 				manualRes = true;
 
 			// Fetch resolution and target fps
@@ -634,142 +1070,396 @@ int main(int argc, char *argv[])
 			targetFps = std::round(vr::VRSystem()->GetFloatTrackedDeviceProperty(0, Prop_DisplayFrequency_Float));
 			targetFrametime = 1000.0f / targetFps;
 			hmdHz = targetFps;
+			// The FPS thresholds are set for the rate the HMD had before our refresh rate switches,
+			// a change we didn't make (e.g. in the SteamVR settings) becomes the new reference
+			if (thresholdBaseHz == 0 || (hmdHz != previousHmdHz && (!config.refreshRateEnabled || hmdHz != requestedHmdHz)))
+				thresholdBaseHz = hmdHz;
+			else if (hmdHz != previousHmdHz)
+			{
+				resetResStateMachine(resStateMachine, currentRes, currentTime);
+				resetTransitionBaseline(transitionDetector);
+				traceTransitionReset(frameHistory, transition);
+			}
+			previousHmdHz = hmdHz;
 			hmdFrametime = targetFrametime;
 			if(!settingFlag){
-				resIncreaseThresholdFPS = hmdHz;
-				resDecreaseThresholdFPS = (int)(hmdHz * 0.5);
+				draftConfig.resIncreaseThresholdFPS = hmdHz;
+				draftConfig.resDecreaseThresholdFPS = (int)(hmdHz * 0.5);
+				publishDraftConfig();
 				saveSettings();
 				settingFlag = true;
 			}
 
-			// Define totals
-			float totalGpuTime = 0;
-			float totalCpuTime = 0;
-			int frameShownTotal = 0;
+			// Scaled to the current rate, never written back into the settings
+			float thresholdScale = config.refreshRateEnabled ? (float)hmdHz / thresholdBaseHz : 1.0f;
+			float increaseThresholdFps = config.resIncreaseThresholdFPS * thresholdScale;
+			float decreaseThresholdFps = config.resDecreaseThresholdFPS * thresholdScale;
+
+			// Frames rendered in the averaging window
+			int windowFrames = std::max(getWindowFrames(frameHistory, config.dataAverageMs), 1);
+			int windowSamples = std::min(windowFrames, frameHistory.size);
+
+			// Mean, variance, min/max and histogram of every column, frametimes bucketed up to twice the target
+			windowHistogramMaxMs = targetFrametime * 2;
+			reduceFrameColumns(frameHistory.columns, windowSamples, windowHistogramMaxMs, windowStats);
+			setFrameStages(windowStats, windowSamples, frameStages);
+
+			// Reason reprojection is happening, from the flags of each frame
+			reprojectionStats = ReprojectionStats();
+			for (int age = 0; age < windowSamples; age++)
+				countReprojectionReasons(getHistoryFrame(frameHistory, age), reprojectionStats);
+
+			// Columns of the window, oldest first
+			// CPU frametime is compositor + application & late start
+			// https://github.com/Louka3000/OpenVR-Dynamic-Resolution/issues/18#issuecomment-1833105172
+			const float *windowGpuTimes = getFrameColumn(frameHistory.columns, FrameColumn::GpuTime, windowSamples);
+			const float *windowCpuTimes = getFrameColumn(frameHistory.columns, FrameColumn::CpuTime, windowSamples);
+			// How many times each frame was shown (>1 = reprojecting)
+			const float *windowPresents = getFrameColumn(frameHistory.columns, FrameColumn::Presents, windowSamples);
+
+			// Newer frames weigh more with a half-life
+			const float *weights = nullptr;
+			if (config.dataAverageHalfLifeMs > 0)
+			{
+				windowWeights.resize(windowSamples);
+				for (int age = 0; age < windowSamples; age++)
+					windowWeights[windowSamples - 1 - age] = getFrameWeight(frameHistory, age, config.dataAverageHalfLifeMs);
+				weights = windowWeights.data();
+			}
 
-			// Loop through past frames
-			frameTiming->m_nSize = sizeof(Compositor_FrameTiming);
-			vr::VRCompositor()->GetFrameTimings(frameTiming, dataAverageSamples);
-			for (int i = 0; i < dataAverageSamples; i++)
+			// Calculate averages, leaving out hitches so they don't pass for sustained load
+			robustAverage(windowGpuTimes, weights, windowSamples, (RobustEstimator)config.robustEstimator, robustScratch, gpuTimeAverage);
+			robustAverage(windowCpuTimes, weights, windowSamples, (RobustEstimator)config.robustEstimator, robustScratch, cpuTimeAverage);
+			averageGpuTime = gpuTimeAverage.mean;
+			averageCpuTime = cpuTimeAverage.mean;
+			if (weights)
 			{
-				// Get GPU frametime
-				float gpuTime = frameTiming[i].m_flTotalRenderGpuMs;
-
-				// Calculate CPU frametime
-				// https://github.com/Louka3000/OpenVR-Dynamic-Resolution/issues/18#issuecomment-1833105172
-				float cpuTime = frameTiming[i].m_flCompositorRenderCpuMs									 // Compositor
-								+ (frameTiming[i].m_flNewFrameReadyMs - frameTiming[i].m_flNewPosesReadyMs); // Application & Late Start
-
-				// How many times the current frame repeated (>1 = reprojecting)
-				int frameShown = std::max((int)frameTiming[i].m_nNumFramePresents, 1);
-				// Reason reprojection is happening
-				int reprojectionFlag = frameTiming[i].m_nReprojectionFlags;
-
-				// Add to totals
-				totalGpuTime += gpuTime;
-				totalCpuTime += cpuTime;
-				frameShownTotal += frameShown;
+				float frameShownTotal = 0;
+				float totalWeight = 0;
+				for (int i = 0; i < windowSamples; i++)
+				{
+					frameShownTotal += windowPresents[i] * weights[i];
+					totalWeight += weights[i];
+				}
+				// (the newest frame always weighs 1)
+				averageFrameShown = frameShownTotal / std::max(totalWeight, 1.0f);
+			}
+			else
+			{
+				averageFrameShown = windowStats[(int)FrameColumn::Presents].mean;
 			}
 
-			// Calculate averages
-			averageGpuTime = totalGpuTime / dataAverageSamples;
-			averageCpuTime = totalCpuTime / dataAverageSamples;
-			averageFrameShown = (float)frameShownTotal / (float)dataAverageSamples;
-			long currentTime = getCurrentTimeMillis();
-			vrCompositor->GetCumulativeStats(&stats, sizeof(stats));
-			
-			// 实际帧率计算
-			uint32_t currentFramePresents = stats.m_nNumFramePresents;
-			uint32_t frameDelta = currentFramePresents - previousFramePresents;
-			double actualFPS = frameDelta * 1000 / (currentTime - lastChangeTime); 
+			// Log isolated spikes among the frames not checked yet (the newest needs a newer neighbour first)
+			for (int age = windowSamples - 2; age >= 1; age--)
+			{
+				const Compositor_FrameTiming &frame = getHistoryFrame(frameHistory, age);
+				if (frame.m_nFrameIndex <= lastSpikeCheckedFrame)
+					continue;
+				int i = windowSamples - 1 - age;
+				bool gpuSpike = isIsolatedSpike(windowGpuTimes, windowSamples, i, gpuTimeAverage, minSpikeMs);
+				bool cpuSpike = isIsolatedSpike(windowCpuTimes, windowSamples, i, cpuTimeAverage, minSpikeMs);
+				if (gpuSpike || cpuSpike)
+				{
+					frameSpikes++;
+					recentSpikes.insert(recentSpikes.begin(), {frame.m_nFrameIndex, currentTime, windowGpuTimes[i], windowCpuTimes[i]});
+					if (recentSpikes.size() > shownSpikes)
+						recentSpikes.pop_back();
+				}
+			}
+			if (windowSamples > 1)
+				lastSpikeCheckedFrame = getHistoryFrame(frameHistory, 1).m_nFrameIndex;
 			lastChangeTime = currentTime;
-			// 输出结果
-			//std::cout << "Actual FPS: " << actualFPS << std::endl;
-			previousFramePresents = currentFramePresents;
-			// Estimated current FPS
-			currentFps = actualFPS;
-			//currentFps = targetFps / averageFrameShown;
-			//printf("averageFrameShown %f\n", averageFrameShown);
+			telemetryChanged = true;
+
+			// Actual FPS, from the compositor's timestamps of the frames in the window
+			FrameRateStats frameRate;
+			computeFrameRate(frameHistory, windowFrames, frameRate);
+			currentFps = frameRate.fps;
+
+			// How evenly the frames were delivered, judder can hide behind a good average
+			computeFramePacing(frameHistory, windowFrames, hmdFrametime, framePacing);
+			jittery = config.jitterLimitEnabled && framePacing.intervalStdDevMs > config.jitterThresholdMs;
+
+			// Dropped, reprojected, timed out and loading frames since the last tick
+			updateCumulativeStats(cumulativeStatsTracker, currentTime, cumulativeRates);
+
+			// Sample the scene application's threads to know if it is really CPU-bound
+			if (config.cpuMonitorEnabled)
+				sampleSceneCpuUsage(vr::VRApplications()->GetCurrentSceneProcessId(), sceneCpuUsage);
+			else
+				sceneCpuUsage = SceneCpuUsage();
+			cpuBound = sceneCpuUsage.valid && sceneCpuUsage.busiestThreadPercent >= config.cpuBoundThreshold;
+			// The CPU frametime estimate is only trusted if the busiest thread is saturated
+			bool cpuTimeConfirmed = !sceneCpuUsage.valid || cpuBound;
+
 			// Double the target frametime if the user wants to,
 			// or if CPU Frametime is double the target frametime,
-			// or if preferReprojection is true and CPU Frametime is greated than targetFrametime.
-			if ((((averageCpuTime > targetFrametime && preferReprojection) ||
+			// or if config.preferReprojection is true and CPU Frametime is greated than targetFrametime.
+			if ((((averageCpuTime > targetFrametime && config.preferReprojection) ||
 				  averageCpuTime / 2 > targetFrametime) &&
-				 !ignoreCpuTime) ||
-				alwaysReproject)
+				 cpuTimeConfirmed && !config.ignoreCpuTime) ||
+				config.alwaysReproject)
 			{
 				targetFps /= 2;
 				targetFrametime *= 2;
 			}
 
 	getGPUInfo();
+
+			// Where VRAM usage is heading, and what a resolution percent costs at the current render target size
+			updateVramForecast(vramForecast, vramUsed, currentTime);
+			vramSecondsToLimit = getSecondsToVramLimit(vramForecast, config.vramLimit / 100.0f);
+			uint32_t renderWidth = 0;
+			uint32_t renderHeight = 0;
+			vr::VRSystem()->GetRecommendedRenderTargetSize(&renderWidth, &renderHeight);
+			vramPerStepGB = getVramPerResStepGB(renderWidth, renderHeight, currentRes);
+
+			// GPU utilization shifts too when the scene changes, and wait for the new scene to be stable
+			double frameTimeS = frameHistory.size > 0 ? getHistoryFrame(frameHistory, 0).m_flSystemTimeInSeconds : 0;
+			bool usageSettling = isSettleMeasurementPending();
+			bool usageChangePoint = !usageSettling && updateTransitionUsage(transitionDetector, (float)gpuUsage, frameTimeS);
+			transition = isInTransition(transitionDetector, frameTimeS, config.transitionHoldMs, transitionMaxHoldMs) && config.transitionDetection;
+			if (isFrameTraceOpen())
+			{
+				FrameTraceRow row;
+				row.timeS = frameTimeS;
+				row.event = FrameTraceEvent::Usage;
+				row.gpuUsage = gpuUsage;
+				row.settling = usageSettling;
+				row.changePoint = usageChangePoint;
+				row.transition = transition;
+				writeFrameTraceRow(row);
+			}
 #pragma endregion
 
 #pragma region Resolution adjustment
-			// Get the current application key
-			std::string appKey = getCurrentApplicationKey();
-			adjustResolution = shouldAdjustResolution(appKey, manualRes, averageCpuTime);
-			if (adjustResolution)
+			// The current application key, looked up when the scene app changed
+			const std::string &appKey = profileAppKey;
+			adjustResolution = shouldAdjustResolution(config, appKey, manualRes, averageCpuTime);
+
+			// Supersampling doesn't reduce the compositor's own GPU work. It shares the frame budget with the app so the
+			// full GPU time is compared against it, but the steps only scale with the part the resolution changes.
+			float scalableFraction = 1.0f;
+			if (config.subtractCompositorGpu && averageGpuTime > 0)
+				scalableFraction = std::clamp((averageGpuTime - frameStages.compositorRenderGpu) / averageGpuTime, 0.0f, 1.0f);
+
+			// Space decisions and size steps according to how expensive resolution changes are for this app
+			int increaseMin = config.resIncreaseMin;
+			int decreaseMin = config.resDecreaseMin;
+			const ResChangeCost *resChangeCost = getResChangeCost(appKey);
+			currentSettleMs = resChangeCost ? resChangeCost->settleMs : 0;
+			currentSpikeMs = resChangeCost ? resChangeCost->spikeMs : 0;
+			if (config.adaptiveResChangeDelay)
+			{
+				currentResChangeDelayMs = getAdaptiveResChangeDelayMs(appKey, config.resChangeDelayMs, config.resChangeDelayMinMs, config.resChangeDelayMaxMs);
+				increaseMin = getAdaptiveResChangeMin(appKey, config.resIncreaseMin, targetFrametime);
+				decreaseMin = getAdaptiveResChangeMin(appKey, config.resDecreaseMin, targetFrametime);
+			}
+			else
+			{
+				currentResChangeDelayMs = config.resChangeDelayMs;
+			}
+			// Hold the resolution while the application is loading, its frametimes mean nothing
+			loading = config.pauseOnLoading && isLoading(cumulativeRates);
+			if (adjustResolution && !loading && !transition)
 			{
 				// Adjust resolution
-				if ((averageCpuTime > minCpuTimeThreshold || vramOnlyMode))
+				if ((averageCpuTime > config.minCpuTimeThreshold || config.vramOnlyMode))
 				{
 					// Frametime
-					if (currentFps >= resIncreaseThresholdFPS && ((vramUsed < vramTarget / 100.0f && vramMonitorEnabled) || !vramMonitorEnabled) && !vramOnlyMode &&
-					 ((gpuUsage < GPUusageLimit && GPUusageEnabled) || !GPUusageEnabled) && ((ramUsed < ramLimit / 100.0f && ramMonitorEnabled) || !ramMonitorEnabled))
+					if (currentFps >= increaseThresholdFps && ((vramUsed < config.vramTarget / 100.0f && config.vramMonitorEnabled) || !config.vramMonitorEnabled) && !config.vramOnlyMode &&
+					 ((gpuUsage < config.GPUusageLimit && config.GPUusageEnabled) || !config.GPUusageEnabled) && ((ramUsed < config.ramLimit / 100.0f && config.ramMonitorEnabled) || !config.ramMonitorEnabled) &&
+					 !cpuBound && // GPU headroom is useless if the game can't produce frames any faster
+					 !jittery)
 					{
 						// Increase resolution
-						if(averageGpuTime < (1000.f / resIncreaseThresholdFPS)){
-							newRes += (((1000.f / resIncreaseThresholdFPS) - averageGpuTime) *
-									(resIncreaseScale / 100.0f)) +
-									resIncreaseMin;
+						if(averageGpuTime < (1000.f / increaseThresholdFps)){
+							newRes += (((1000.f / increaseThresholdFps) - averageGpuTime) * scalableFraction *
+									(config.resIncreaseScale / 100.0f)) +
+									increaseMin;
 						}
 
 					}
-					else if (currentFps < resDecreaseThresholdFPS && !vramOnlyMode && (gpuUsage > GPUusageTarget && GPUusageEnabled) && (ramUsed < ramLimit / 100.0f && ramMonitorEnabled))
+					else if (currentFps < decreaseThresholdFps && !config.vramOnlyMode && (gpuUsage > config.GPUusageTarget && config.GPUusageEnabled) && (ramUsed < config.ramLimit / 100.0f && config.ramMonitorEnabled) &&
+							 (!config.reprojectionReasonAware || isReprojectionGpuBound(reprojectionStats))) // Lowering the resolution doesn't help CPU-caused reprojection
 					{
 						// Decrease resolution
-						if(averageGpuTime > (1000.f / resDecreaseThresholdFPS)){
-							newRes -= ((averageGpuTime - (1000.f / resDecreaseThresholdFPS)) *
-									(resDecreaseScale / 100.0f)) +
-									resDecreaseMin;
+						if(averageGpuTime > (1000.f / decreaseThresholdFps)){
+							newRes -= ((averageGpuTime - (1000.f / decreaseThresholdFps)) * scalableFraction *
+									(config.resDecreaseScale / 100.0f)) +
+									decreaseMin;
 						}
 
 					}
 
 					// VRAM
-					if (vramUsed > vramLimit / 100.0f && ((ramUsed < ramLimit / 100.0f && ramMonitorEnabled) || !ramMonitorEnabled))
+					bool ramAvailable = (ramUsed < config.ramLimit / 100.0f && config.ramMonitorEnabled) || !config.ramMonitorEnabled;
+					if (vramUsed > config.vramLimit / 100.0f && ramAvailable)
 					{
-						// Force the resolution to decrease when the vram limit is reached
-						newRes -= resDecreaseMin;
+						// Force the resolution to decrease when the vram limit is reached, by enough to get back under it
+						float excessGB = (vramUsed - config.vramLimit / 100.0f) * vramTotalGB;
+						newRes -= getVramBackOffSteps(excessGB, vramPerStepGB, decreaseMin);
 					}
-					else if (vramOnlyMode && newRes < initialRes && vramUsed < vramTarget / 100.0f)
+					else if (config.vramForecastEnabled && config.vramMonitorEnabled && vramSecondsToLimit >= 0 && vramSecondsToLimit < config.vramForecastSeconds && ramAvailable)
+					{
+						// The limit will be reached soon, back off by what the growth will take before it's too late
+						float excessGB = (forecastVramUsed(vramForecast, (float)config.vramForecastSeconds) - config.vramLimit / 100.0f) * vramTotalGB;
+						newRes = std::min(newRes, lastRes) - getVramBackOffSteps(excessGB, vramPerStepGB, decreaseMin);
+					}
+					else if (config.vramOnlyMode && newRes < config.initialRes && vramUsed < config.vramTarget / 100.0f)
 					{
 						// When in VRAM-only mode, make sure the res goes back up when possible.
-						newRes = std::min(initialRes, (int)std::round(newRes) + resIncreaseMin);
+						newRes = std::min(config.initialRes, (int)std::round(newRes) + increaseMin);
 					}
 
 					// Clamp the new resolution
-					newRes = std::clamp((int)std::round(newRes), minRes, maxRes);
+					newRes = std::clamp((int)std::round(newRes), config.minRes, config.maxRes);
+
+					// Second knob: lower the refresh rate rather than the resolution below the quality floor,
+					// and go back up when frames would fit in the higher rate's frametime
+					if (config.refreshRateEnabled)
+					{
+						if (refreshRatePolicy.rates.empty())
+							loadAvailableRefreshRates(refreshRatePolicy);
+						bool overBudgetAtFloor = newRes < std::round(lastRes) && newRes < config.refreshRateResFloor;
+						if (overBudgetAtFloor && getNeighbourRefreshRate(refreshRatePolicy, (float)hmdHz, -1) > 0)
+							newRes = std::max(newRes, std::min(std::round(lastRes), (float)config.refreshRateResFloor));
+
+						RefreshRateConfig refreshRateConfig;
+						refreshRateConfig.dwellMs = config.refreshRateDwellMs;
+						float refreshRate = updateRefreshRatePolicy(refreshRatePolicy, refreshRateConfig, (float)hmdHz, overBudgetAtFloor,
+																	std::max(averageGpuTime, averageCpuTime), currentTime);
+						if (refreshRate > 0)
+						{
+							setPreferredRefreshRate(refreshRatePolicy, refreshRate);
+							requestedHmdHz = (int)std::round(refreshRate);
+						}
+					}
+
+					// Only let sustained decisions through, and fall back to the last good resolution when a probe fails
+					if (config.hysteresisEnabled)
+					{
+						float roundedLastRes = std::round(lastRes);
+						ResIntent intent = newRes > roundedLastRes ? ResIntent::Increase : (newRes < roundedLastRes ? ResIntent::Decrease : ResIntent::Hold);
+						ResStateConfig resStateConfig{config.increaseConfidence, config.decreaseConfidence, config.probeDwellMs, config.cooldownMs};
+						newRes = updateResStateMachine(resStateMachine, resStateConfig, intent, roundedLastRes, newRes, currentTime);
+						newRes = std::clamp((int)std::round(newRes), config.minRes, config.maxRes);
+					}
+
+					// Align the render target on whole GPU tiles, and skip changes that wouldn't change it.
+					// Last so the resolution that is applied is the snapped one, fallbacks included.
+					if (config.renderTargetSnap)
+						newRes = std::clamp(snapResToTiles(newRes, lastRes, renderWidth, renderHeight, currentRes, config.renderTargetTile),
+											(float)config.minRes, (float)config.maxRes);
 				}
 			}
-			else if ((appKey == "" || (resetOnThreshold && averageCpuTime < minCpuTimeThreshold)) && !manualRes)
+			else if ((appKey == "" || (config.resetOnThreshold && averageCpuTime < config.minCpuTimeThreshold)) && !manualRes && !loading)
 			{
 				// If (in SteamVR void or cpuTime below threshold) and user didn't pause res
-				// Reset to initialRes
-				newRes = initialRes;
+				// Reset to config.initialRes
+				newRes = config.initialRes;
+				resetResStateMachine(resStateMachine, newRes, currentTime);
 			}
 
 			if (newRes != lastRes)
 			{
 				// Sets the new resolution
 				vr::VRSettings()->SetFloat(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_SupersampleScale_Float, newRes / 100.0f);
+
+				// Measure how this app copes with the change
+				if (adjustResolution && lastRes > 0)
+					beginSettleMeasurement(appKey, frameHistory.lastFrameIndex, averageGpuTime, newRes / lastRes);
+				resetTransitionBaseline(transitionDetector);
+				traceTransitionReset(frameHistory, transition);
+			}
+
+			// Record the decision
+			if (config.traceEnabled && !isTraceOpen())
+				openTrace(tracePath);
+			else if (!config.traceEnabled && isTraceOpen())
+				closeTrace();
+			if (isTraceOpen())
+			{
+				TraceRow row;
+				row.timeMs = currentTime;
+				row.appKey = appKey;
+				row.fps = currentFps;
+				row.gpuTime = averageGpuTime;
+				row.cpuTime = averageCpuTime;
+				row.resolution = lastRes;
+				row.newResolution = newRes;
+				row.vramUsed = vramUsed;
+				row.gpuUsage = gpuUsage;
+				row.presentsPerSecond = cumulativeRates.presentsPerSecond;
+				row.droppedPerSecond = cumulativeRates.droppedPerSecond;
+				row.reprojectedPerSecond = cumulativeRates.reprojectedPerSecond;
+				row.timedOutPerSecond = cumulativeRates.timedOutPerSecond;
+				row.loadingPerSecond = cumulativeRates.loadingPerSecond;
+				row.startupPresentsPerSecond = cumulativeRates.startupPresentsPerSecond;
+				row.startupDroppedPerSecond = cumulativeRates.startupDroppedPerSecond;
+				row.startupReprojectedPerSecond = cumulativeRates.startupReprojectedPerSecond;
+				row.loadingDroppedPerSecond = cumulativeRates.loadingDroppedPerSecond;
+				row.loadingReprojectedPerSecond = cumulativeRates.loadingReprojectedPerSecond;
+				row.timedOutDroppedPerSecond = cumulativeRates.timedOutDroppedPerSecond;
+				row.timedOutReprojectedPerSecond = cumulativeRates.timedOutReprojectedPerSecond;
+				row.submitsPerSecond = cumulativeRates.submitsPerSecond;
+				row.submitsWithDepthPerSecond = cumulativeRates.submitsWithDepthPerSecond;
+				row.applicationCpuMs = cumulativeRates.applicationCpuMs;
+				row.applicationGpuMs = cumulativeRates.applicationGpuMs;
+				row.compositorCpuMs = cumulativeRates.compositorCpuMs;
+				row.compositorGpuMs = cumulativeRates.compositorGpuMs;
+				row.targetFrameMs = cumulativeRates.targetFrameMs;
+				row.transition = transition;
+				row.changePoints = transitionDetector.changePoints;
+				row.frameSpikes = frameSpikes;
+				row.gpuOutliers = gpuTimeAverage.outliers;
+				row.jitterMs = framePacing.intervalStdDevMs;
+				row.judder = framePacing.judder;
+				row.maxMissedVsyncs = framePacing.maxMissedVsyncs;
+				row.vramTrend = vramForecast.trend;
+				row.vramSecondsToLimit = vramSecondsToLimit;
+				writeTraceRow(row);
 			}
 		}
 #pragma endregion
 
+		// Add a point to the history graphs
+		if (takeTelemetrySample(telemetryAccumulator, currentTime, telemetrySampleMs, telemetrySample))
+		{
+			telemetrySample.targetFrametimeMs = targetFrametime;
+			telemetrySample.resolution = newRes;
+			telemetrySample.vramUsed = vramUsed * 100;
+			telemetrySample.gpuUsage = (float)gpuUsage;
+			publishTelemetrySample(telemetryRing, telemetrySample);
+			if (historyShown)
+				telemetryChanged = true;
+		}
+
+		// Check if OpenVR is quitting so we can quit alongside it
+		VREvent_t vrEvent;
+		while (vr::VRSystem()->PollNextEvent(&vrEvent, sizeof(vr::VREvent_t)))
+		{
+			if (vrEvent.eventType == vr::VREvent_Quit)
+			{
+				vr::VRSystem()->AcknowledgeQuit_Exiting();
+				openvrQuit = true;
+				break;
+			}
+		}
+
 #pragma region Gui rendering
-		glfwPollEvents();
+		// Only build a frame when something changed, and never while minimized or hidden in the tray
+		now = std::chrono::steady_clock::now();
+		bool wasWindowVisible = windowVisible;
+		windowVisible = glfwGetWindowAttrib(glfwWindow, GLFW_VISIBLE) && !glfwGetWindowAttrib(glfwWindow, GLFW_ICONIFIED);
+		if (windowVisible && !wasWindowVisible)
+			requestRedraw();
+		bool inputDue = (now < redrawUntil || guiActive) && now >= lastRenderTime + refreshIntervalFocused;
+		bool telemetryDue = telemetryChanged && now >= lastRenderTime + refreshIntervalBackground;
+		if (!windowVisible || (!inputDue && !telemetryDue))
+			continue;
+		lastRenderTime = now;
+		telemetryChanged = false;
 
 		// Start the Dear ImGui frame
 		ImGui_ImplOpenGL3_NewFrame();
@@ -783,80 +1473,95 @@ int main(int argc, char *argv[])
 		if (!showSettings)
 		{
 			// Create the main window
-			ImGui::Begin("Main", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar);
+			ImGui::Begin("Main", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
 
 			// Set position and size to fill the viewport
 			ImGui::SetWindowPos(ImVec2(0, 0));
 			ImGui::SetWindowSize(ImVec2(mainWindowWidth, mainWindowHeight));
 
 			// Title
-			ImGui::Text("%s", LanguageManager::getInstance().translate("app_title").c_str());
+			ImGui::Text("%s", LanguageManager::getInstance().translate(Str::app_title));
 
 			ImGui::Separator();
 			ImGui::NewLine();
 
 			// 使用 UTF-8 字面量
 			// HMD Hz
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("hmd_refresh_rate"), hmdHz, hmdFrametime).c_str());
+			ImGui::Text("%s", formatTranslation<Str::hmd_refresh_rate>(hmdHz, hmdFrametime));
 			// 在渲染代码中使用翻译
 			// Target FPS and frametime
-			if (!vramOnlyMode)
+			if (!config.vramOnlyMode)
 			{
-				ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("target_fps"), targetFps, targetFrametime).c_str());
+				ImGui::Text("%s", formatTranslation<Str::target_fps>(targetFps, targetFrametime));
 			}
 			else
 			{
-				ImGui::Text("%s", LanguageManager::getInstance().translate("target_fps_disabled").c_str());
+				ImGui::Text("%s", LanguageManager::getInstance().translate(Str::target_fps_disabled));
 			}
 			// VRAM target and limit
 			if (GPUEnabled && GPUEnabled)
 			{
-				ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("target_VRAM"), vramTarget / 100.f * vramTotalGB).c_str());
-				ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("limit_VRAM"), vramLimit / 100.f * vramTotalGB).c_str());
+				ImGui::Text("%s", formatTranslation<Str::target_VRAM>(config.vramTarget / 100.f * vramTotalGB));
+				ImGui::Text("%s", formatTranslation<Str::limit_VRAM>(config.vramLimit / 100.f * vramTotalGB));
 			}
 			else{
-				ImGui::Text("%s", LanguageManager::getInstance().translate("target_VRAM_disabled").c_str());
-				ImGui::Text("%s", LanguageManager::getInstance().translate("limit_VRAM_disabled").c_str());
+				ImGui::Text("%s", LanguageManager::getInstance().translate(Str::target_VRAM_disabled));
+				ImGui::Text("%s", LanguageManager::getInstance().translate(Str::limit_VRAM_disabled));
 			}
 
 			ImGui::NewLine();
 
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("FPS").c_str(), currentFps).c_str());
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("GPU_frametime").c_str(), averageGpuTime).c_str());
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("CPU_frametime").c_str(), averageCpuTime).c_str());
+			ImGui::Text("%s", formatTranslation<Str::FPS>(currentFps));
+			if (jittery)
+				ImGui::Text("%s", formatTranslation<Str::Frame_pacing_limited>(framePacing.intervalStdDevMs, framePacing.judder, framePacing.maxMissedVsyncs));
+			else
+				ImGui::Text("%s", formatTranslation<Str::Frame_pacing>(framePacing.intervalStdDevMs, framePacing.judder, framePacing.maxMissedVsyncs));
+			ImGui::Text("%s", formatTranslation<Str::GPU_frametime>(averageGpuTime));
+			ImGui::Text("%s", formatTranslation<Str::CPU_frametime>(averageCpuTime));
+			// Busiest thread of the scene application
+			if (sceneCpuUsage.valid && cpuBound)
+				ImGui::Text("%s", formatTranslation<Str::CPU_thread_usage_bound>(sceneCpuUsage.busiestThreadPercent, sceneCpuUsage.threadCount));
+			else if (sceneCpuUsage.valid)
+				ImGui::Text("%s", formatTranslation<Str::CPU_thread_usage>(sceneCpuUsage.busiestThreadPercent, sceneCpuUsage.threadCount));
+			else
+				ImGui::Text("%s", LanguageManager::getInstance().translate(Str::CPU_thread_usage_disabled));
 
 			// VRAM usage
-			if (vramMonitorEnabled){
-				ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("VRAM_usage").c_str(), vramUsedGB, vramTotalGB, (int)(vramUsed * 100)).c_str());
-				//ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("VRAM_usage").c_str(), vramTotalGB).c_str());
+			if (config.vramMonitorEnabled){
+				ImGui::Text("%s", formatTranslation<Str::VRAM_usage>(vramUsedGB, vramTotalGB, (int)(vramUsed * 100)));
+				//ImGui::Text("%s", formatTranslation<Str::VRAM_usage>(vramTotalGB));
 				//printf("VRAM: %f\n", vramUsedGB);
 			}
 
 			else
 			{
-				ImGui::Text("%s", LanguageManager::getInstance().translate("VRAM_usage_disabled").c_str());
+				ImGui::Text("%s", LanguageManager::getInstance().translate(Str::VRAM_usage_disabled));
 			}
 			
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("GPU_usage").c_str(), gpuUsage).c_str());
+			ImGui::Text("%s", formatTranslation<Str::GPU_usage>(gpuUsage));
 			//ImGui::Text("%s", fmt::format("GPU使用率 {} %", gpuUsage).c_str());
 
 			ImGui::NewLine();
 			// RAM usage
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("RAM_usage").c_str(), ramUsedGB, ramTotalGB, (int)(ramUsed * 100)).c_str());
+			ImGui::Text("%s", formatTranslation<Str::RAM_usage>(ramUsedGB, ramTotalGB, (int)(ramUsed * 100)));
 
 			ImGui::NewLine();
 			// Reprojection ratio
-			ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("Reprojection_ratio"), averageFrameShown - 1).c_str());
+			ImGui::Text("%s", formatTranslation<Str::Reprojection_ratio>(averageFrameShown - 1));
 			// Current resolution
 			if (manualRes)
 			{
-				ImGui::Text("%s", LanguageManager::getInstance().translate("Resolution_info_2").c_str());
+				ImGui::Text("%s", LanguageManager::getInstance().translate(Str::Resolution_info_2));
 			}
 			else
 			{
-				ImGui::Text("%s", fmt::format(LanguageManager::getInstance().translate("Resolution_info"), newRes).c_str());
+				ImGui::Text("%s", formatTranslation<Str::Resolution_info>(newRes));
 			}
 
+			// Resolution change interval
+			if (config.adaptiveResChangeDelay)
+				ImGui::Text("%s", formatTranslation<Str::Res_change_interval>(currentResChangeDelayMs, currentSettleMs, currentSpikeMs));
+
 			// Resolution adjustment status
 			if (!adjustResolution)
 			{
@@ -873,26 +1578,139 @@ int main(int argc, char *argv[])
 				}
 				else
 				{
-					ImGui::Text("%s", lang.translate("Adjustment_paused").c_str());
+					ImGui::Text("%s", lang.translate(Str::Adjustment_paused));
 				}
 			}
 
 			ImGui::NewLine();
 
 			// Open settings
-			bool settingsPressed = ImGui::Button(lang.translate("Settings").c_str(), ImVec2(82, 28));
+			bool settingsPressed = ImGui::Button(lang.translate(Str::Settings), ImVec2(82, 28));
 			if (settingsPressed)
 				showSettings = true;
 
 			// Resolution pausing
 			ImGui::SameLine();
 
-			std::string pauseText = lang.translate(manualRes ? "Dynamic_resolution" : "Manual_resolution");
-			bool pausePressed = ImGui::Button(pauseText.c_str(), ImVec2(142, 28));
+			const char *pauseText = lang.translate(manualRes ? Str::Dynamic_resolution : Str::Manual_resolution);
+			bool pausePressed = ImGui::Button(pauseText, ImVec2(142, 28));
 			if (pausePressed)
 			{
 				manualRes = !manualRes;
-				adjustResolution = shouldAdjustResolution(getCurrentApplicationKey(), manualRes, averageCpuTime);
+				adjustResolution = shouldAdjustResolution(config, getCurrentApplicationKey(), manualRes, averageCpuTime);
+				resetResStateMachine(resStateMachine, newRes, getCurrentTimeMillis());
+			}
+
+			// Controller internals, mostly useful to tune the settings
+			if (ImGui::TreeNodeEx(lang.translate(Str::Diagnostics), ImGuiTreeNodeFlags_NoTreePushOnOpen))
+			{
+				// Frame budget per stage, the full bar being the target frametime
+				const ImU32 stageColours[] = {IM_COL32(70, 130, 200, 255), IM_COL32(110, 180, 240, 255), IM_COL32(220, 150, 60, 255), IM_COL32(140, 140, 140, 255)};
+				float gpuStages[] = {frameStages.preSubmitGpu, frameStages.postSubmitGpu, frameStages.compositorRenderGpu,
+									 std::max(frameStages.totalRenderGpu - frameStages.preSubmitGpu - frameStages.postSubmitGpu - frameStages.compositorRenderGpu, 0.0f)};
+				ImGui::Text("%s", formatTranslation<Str::GPU_stages>(frameStages.totalRenderGpu, targetFrametime));
+				drawStackedBar(gpuStages, stageColours, 4, targetFrametime);
+				drawLegendItem(stageColours[0], lang.translate(Str::Stage_pre_submit), true);
+				drawLegendItem(stageColours[1], lang.translate(Str::Stage_post_submit), false);
+				drawLegendItem(stageColours[2], lang.translate(Str::Stage_compositor), false);
+				drawLegendItem(stageColours[3], lang.translate(Str::Stage_other), false);
+
+				// Spread of the GPU frametime over the window
+				const ColumnStats &gpuTimeStats = windowStats[(int)FrameColumn::GpuTime];
+				float gpuTimeHistogram[columnHistogramBuckets];
+				for (int i = 0; i < columnHistogramBuckets; i++)
+					gpuTimeHistogram[i] = (float)gpuTimeStats.histogram[i];
+				ImGui::Text("%s", formatTranslation<Str::GPU_time_distribution>(gpuTimeStats.min, gpuTimeStats.max, std::sqrt(gpuTimeStats.variance), windowHistogramMaxMs));
+				ImGui::PlotHistogram("##gpuTimeHistogram", gpuTimeHistogram, columnHistogramBuckets, 0, nullptr, 0, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 40));
+
+				float cpuStages[] = {frameStages.applicationCpu, frameStages.submitFrame, frameStages.compositorRenderCpu, frameStages.waitForPresentCpu};
+				ImGui::Text("%s", formatTranslation<Str::CPU_stages>(frameStages.compositorIdleCpu));
+				drawStackedBar(cpuStages, stageColours, 4, targetFrametime);
+				drawLegendItem(stageColours[0], lang.translate(Str::Stage_application), true);
+				drawLegendItem(stageColours[1], lang.translate(Str::Stage_submit), false);
+				drawLegendItem(stageColours[2], lang.translate(Str::Stage_compositor), false);
+				drawLegendItem(stageColours[3], lang.translate(Str::Stage_wait_present), false);
+
+				// Reprojection causes over the averaging window
+				float reprojectionFrames = (float)std::max(reprojectionStats.frames, 1);
+				ImGui::Text("%s", formatTranslation<Str::Reprojection_reasons>(reprojectionStats.cpu * 100 / reprojectionFrames,
+											  reprojectionStats.gpu * 100 / reprojectionFrames,
+											  reprojectionStats.throttled * 100 / reprojectionFrames,
+											  reprojectionStats.predicted * 100 / reprojectionFrames));
+				ImGui::Text("%s", formatTranslation<Str::Cumulative_rates>(cumulativeRates.droppedPerSecond, cumulativeRates.reprojectedPerSecond, cumulativeRates.timedOutPerSecond));
+				if (cumulativeRates.startupPresents > 0)
+					ImGui::Text("%s", formatTranslation<Str::Startup_rates>(cumulativeRates.startupPresentsPerSecond, cumulativeRates.startupDroppedPerSecond, cumulativeRates.startupReprojectedPerSecond));
+				if (cumulativeRates.loading > 0)
+					ImGui::Text("%s", formatTranslation<Str::Loading_rates>(cumulativeRates.loadingPerSecond, cumulativeRates.loadingDroppedPerSecond, cumulativeRates.loadingReprojectedPerSecond));
+				if (cumulativeRates.timedOut > 0)
+					ImGui::Text("%s", formatTranslation<Str::Timed_out_rates>(cumulativeRates.timedOutPerSecond, cumulativeRates.timedOutDroppedPerSecond, cumulativeRates.timedOutReprojectedPerSecond));
+				if (cumulativeRates.submits > 0)
+				{
+					ImGui::Text("%s", formatTranslation<Str::Submit_rates>(cumulativeRates.submitsPerSecond, cumulativeRates.submitsWithDepth * 100.0f / cumulativeRates.submits, cumulativeRates.targetFrameMs));
+					ImGui::Text("%s", formatTranslation<Str::Submitted_frame_means>(cumulativeRates.applicationCpuMs, cumulativeRates.applicationGpuMs, cumulativeRates.compositorCpuMs, cumulativeRates.compositorGpuMs));
+				}
+				if (loading)
+					ImGui::Text("%s", formatTranslation<Str::Loading_paused>(cumulativeRates.loadingPerSecond));
+				if (transition)
+					ImGui::Text("%s", lang.translate(Str::Transition_paused));
+				ImGui::Text("%s", formatTranslation<Str::Change_points>(transitionDetector.changePoints));
+				if (config.refreshRateEnabled)
+					ImGui::Text("%s", formatTranslation<Str::Refresh_rate_state>(hmdHz, refreshRatePolicy.rates.size(), refreshRatePolicy.switches));
+				if (config.vramMonitorEnabled)
+				{
+					float vramTrendMBs = vramForecast.trend * vramTotalGB * 1024;
+					if (vramSecondsToLimit >= 0)
+						ImGui::Text("%s", formatTranslation<Str::VRAM_forecast>(vramTrendMBs, vramSecondsToLimit, vramPerStepGB * 1024));
+					else
+						ImGui::Text("%s", formatTranslation<Str::VRAM_forecast_stable>(vramTrendMBs, vramPerStepGB * 1024));
+				}
+				ImGui::Text("%s", formatTranslation<Str::Frame_outliers>(gpuTimeAverage.outliers, cpuTimeAverage.outliers, frameSpikes));
+				ImGui::Indent();
+				for (const FrameSpike &spike : recentSpikes)
+					ImGui::Text("%s", formatTranslation<Str::Frame_spike>(spike.frameIndex, (currentTime - spike.timeMs) / 1000.0f, spike.gpuTime, spike.cpuTime,
+																		  gpuTimeAverage.median, cpuTimeAverage.median));
+				ImGui::Unindent();
+				ImGui::Text("%s", formatTranslation<Str::Reprojection_modes>(reprojectionStats.async * 100 / reprojectionFrames,
+											  reprojectionStats.motion * 100 / reprojectionFrames));
+
+				if (config.hysteresisEnabled)
+				{
+					ImGui::Text("%s", formatTranslation<Str::Res_state>(lang.translate(resStateTranslationKey(resStateMachine.state))));
+					ImGui::Text("%s", formatTranslation<Str::Res_changes_per_hour>(getResChangesPerHour(resStateMachine, getCurrentTimeMillis()), resStateMachine.resChanges));
+					ImGui::Text("%s", formatTranslation<Str::Res_state_transitions>(getResStateEntries(resStateMachine, ResState::ProbingUp),
+												  getResStateEntries(resStateMachine, ResState::BackingOff),
+												  getResStateEntries(resStateMachine, ResState::Cooldown),
+												  resStateMachine.failedProbes));
+				}
+			}
+
+			// Recent history, to tell what went wrong in a session
+			historyShown = ImGui::TreeNodeEx(lang.translate(Str::History), ImGuiTreeNodeFlags_NoTreePushOnOpen);
+			addTooltip(lang.translate(Str::Tooltip_history));
+			if (historyShown)
+			{
+				for (int minutes : {1, 5, 10})
+				{
+					if (minutes != 1)
+						ImGui::SameLine();
+					ImGui::RadioButton(formatTranslation<Str::Minutes_short>(minutes), &historySpanMinutes, minutes);
+				}
+				long long historySpanMs = historySpanMinutes * 60000ll;
+				const ImU32 historyColour = IM_COL32(110, 180, 240, 255);
+
+				ImGui::Text("%s", formatTranslation<Str::History_GPU_frametime>(targetFrametime));
+				drawTelemetryGraph(telemetryRing, &TelemetrySample::gpuTimeMs, currentTime, historySpanMs, targetFrametime, historyColour);
+				ImGui::Text("%s", formatTranslation<Str::History_CPU_frametime>(targetFrametime));
+				drawTelemetryGraph(telemetryRing, &TelemetrySample::cpuTimeMs, currentTime, historySpanMs, targetFrametime, historyColour);
+				ImGui::Text("%s", lang.translate(Str::History_resolution));
+				drawTelemetryGraph(telemetryRing, &TelemetrySample::resolution, currentTime, historySpanMs, NAN, historyColour);
+				if (config.vramMonitorEnabled)
+				{
+					ImGui::Text("%s", formatTranslation<Str::History_VRAM>(config.vramLimit));
+					drawTelemetryGraph(telemetryRing, &TelemetrySample::vramUsed, currentTime, historySpanMs, (float)config.vramLimit, historyColour);
+				}
+				ImGui::Text("%s", formatTranslation<Str::History_GPU_usage>(config.GPUusageLimit));
+				drawTelemetryGraph(telemetryRing, &TelemetrySample::gpuUsage, currentTime, historySpanMs, (float)config.GPUusageLimit, historyColour);
 			}
 
 			// Stop creating the main window
@@ -905,7 +1723,7 @@ int main(int argc, char *argv[])
 if (showSettings)
 {
     // Create the settings window
-    ImGui::Begin(LanguageManager::getInstance().translate("Settings").c_str(), NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+    ImGui::Begin(LanguageManager::getInstance().translate(Str::Settings), NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
 
     // Set position and size to fill the viewport
     ImGui::SetWindowPos(ImVec2(0, 0));
@@ -915,215 +1733,249 @@ if (showSettings)
     ImGui::PushItemWidth(96);
 
     // Title
-    ImGui::Text(LanguageManager::getInstance().translate("Settings").c_str());
+    ImGui::Text(LanguageManager::getInstance().translate(Str::Settings));
 
     ImGui::Separator();
     ImGui::NewLine();
 
     // GUI settings inputs
-    if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("Startup").c_str()))
+    if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::Startup)))
     {
-        ImGui::Checkbox(LanguageManager::getInstance().translate("Start_with_SteamVR").c_str(), &autoStart);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_start_with_SteamVR").c_str());
-
-        ImGui::Text(LanguageManager::getInstance().translate("Startup_behavior").c_str());
-        ImGui::RadioButton(LanguageManager::getInstance().translate("Visible").c_str(), &minimizeOnStart, 0);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_visible").c_str());
-        ImGui::RadioButton(LanguageManager::getInstance().translate("Minimized_taskbar").c_str(), &minimizeOnStart, 1);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_minimized_taskbar").c_str());
-        ImGui::RadioButton(LanguageManager::getInstance().translate("Hidden_tray").c_str(), &minimizeOnStart, 2);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_hidden_tray").c_str());
+        drawSetting("autoStart");
+
+        ImGui::Text(LanguageManager::getInstance().translate(Str::Startup_behavior));
+        ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Visible), &draftConfig.minimizeOnStart, 0);
+        addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_visible));
+        ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Minimized_taskbar), &draftConfig.minimizeOnStart, 1);
+        addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_minimized_taskbar));
+        ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Hidden_tray), &draftConfig.minimizeOnStart, 2);
+        addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_hidden_tray));
     }
 
-	if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("General").c_str()))
+	if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::General)))
 	{
-		// 添加语言选择的下拉框
-		static const char* languages[] = { "English", "中文", "日本語"}; // 可扩展的语言选项
-		static int selectedLanguageIndex = languageIndex; // 初始选择索引，0对应English
+		// 添加语言选择的下拉框，English 之后是 translations 目录里的语言包
+		auto languageName = [](void *, int index)
+		{ return LanguageManager::getInstance().getLanguageName(index); };
 		// 显示下拉框并更新语言索引
-		if (ImGui::Combo(LanguageManager::getInstance().translate("Select_language").c_str(), &selectedLanguageIndex, languages, IM_ARRAYSIZE(languages)))
+		if (ImGui::Combo(LanguageManager::getInstance().translate(Str::Select_language), &draftConfig.languageIndex, languageName, nullptr, (int)LanguageManager::getInstance().getLanguageCount()))
 		{
-			languageIndex = selectedLanguageIndex;
 			// 更新语言代码，根据索引选择语言
-			setLanguage(languageIndex);
+			setLanguage(draftConfig.languageIndex);
 		}
-		addTooltip(LanguageManager::getInstance().translate("Tooltip_select_language").c_str());
+		addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_select_language));
 
 		// 其他设置项
-		if (ImGui::InputInt(LanguageManager::getInstance().translate("Resolution_change_delay_ms").c_str(), &resChangeDelayMs, 100))
-			resChangeDelayMs = std::max(resChangeDelayMs, 100);
-		addTooltip(LanguageManager::getInstance().translate("Tooltip_resolution_change_delay_ms").c_str());
+		drawSetting("resChangeDelayMs");
 
-		if (ImGui::InputInt(LanguageManager::getInstance().translate("Data_average_samples").c_str(), &dataAverageSamples, 2))
-		{
-			dataAverageSamples = std::clamp(dataAverageSamples, 1, 128); // Max stored by OpenVR
-			frameTiming = new vr::Compositor_FrameTiming[dataAverageSamples];
-		}
-		addTooltip(LanguageManager::getInstance().translate("Tooltip_data_average_samples").c_str());
+		drawSetting("adaptiveResChangeDelay");
+
+		if (drawSetting("resChangeDelayMinMs"))
+			draftConfig.resChangeDelayMinMs = std::clamp(draftConfig.resChangeDelayMinMs, 100, draftConfig.resChangeDelayMaxMs);
+
+		if (drawSetting("resChangeDelayMaxMs"))
+			draftConfig.resChangeDelayMaxMs = std::max(draftConfig.resChangeDelayMaxMs, draftConfig.resChangeDelayMinMs);
 
-				ImGui::Checkbox(LanguageManager::getInstance().translate("External_res_change_compatibility").c_str(), &externalResChangeCompatibility);
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_external_res_change_compatibility").c_str());
+		drawSetting("dataAverageMs");
 
-				ImGui::Text(LanguageManager::getInstance().translate("Blacklist").c_str());
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_blacklist").c_str());
-				if (ImGui::InputTextMultiline(LanguageManager::getInstance().translate("Blacklisted_apps").c_str(), &blacklistApps, ImVec2(130, 60), ImGuiInputTextFlags_CharsNoBlank))
-					blacklistAppsSet = multilineStringToSet(blacklistApps);
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_blacklisted_apps").c_str());
-				if (ImGui::Button(LanguageManager::getInstance().translate("Blacklist_current_app").c_str(), ImVec2(160, 26)))
+		drawSetting("dataAverageHalfLifeMs");
+
+		ImGui::Text("%s", LanguageManager::getInstance().translate(Str::Robust_estimator));
+		addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_robust_estimator));
+		ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Estimator_mean), &draftConfig.robustEstimator, (int)RobustEstimator::Mean);
+		ImGui::SameLine();
+		ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Estimator_median_mad), &draftConfig.robustEstimator, (int)RobustEstimator::MedianMad);
+		ImGui::SameLine();
+		ImGui::RadioButton(LanguageManager::getInstance().translate(Str::Estimator_trimmed_mean), &draftConfig.robustEstimator, (int)RobustEstimator::TrimmedMean);
+
+				drawSetting("externalResChangeCompatibility");
+
+				drawSetting("traceEnabled");
+
+				drawSetting("frameTraceEnabled");
+
+				ImGui::Text(LanguageManager::getInstance().translate(Str::Blacklist));
+				addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_blacklist));
+				if (ImGui::InputTextMultiline(LanguageManager::getInstance().translate(Str::Blacklisted_apps), &blacklistApps, ImVec2(130, 60), ImGuiInputTextFlags_CharsNoBlank))
+					draftConfig.blacklistAppsSet = multilineStringToSet(blacklistApps);
+				addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_blacklisted_apps));
+				if (ImGui::Button(LanguageManager::getInstance().translate(Str::Blacklist_current_app), ImVec2(160, 26)))
 				{
 					std::string appKey = getCurrentApplicationKey();
-					if (!isApplicationBlacklisted(appKey))
+					if (appKey != "" && !draftConfig.blacklistAppsSet.count(appKey))
 					{
-						blacklistAppsSet.insert(appKey);
+						draftConfig.blacklistAppsSet.insert(appKey);
 						if (blacklistApps != "")
 							blacklistApps += "\n";
 						blacklistApps += appKey;
 					}
 				}
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_blacklist_current_app").c_str());
-
-				ImGui::Checkbox(LanguageManager::getInstance().translate("Enable_whitelist").c_str(), &whitelistEnabled);
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_enable_whitelist").c_str());
-				if (ImGui::InputTextMultiline(LanguageManager::getInstance().translate("Whitelisted_apps").c_str(), &whitelistApps, ImVec2(130, 60), ImGuiInputTextFlags_CharsNoBlank))
-					whitelistAppsSet = multilineStringToSet(whitelistApps);
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_whitelisted_apps").c_str());
-				if (ImGui::Button(LanguageManager::getInstance().translate("Whitelist_current_app").c_str(), ImVec2(164, 26)))
+				addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_blacklist_current_app));
+
+				drawSetting("whitelistEnabled");
+				if (ImGui::InputTextMultiline(LanguageManager::getInstance().translate(Str::Whitelisted_apps), &whitelistApps, ImVec2(130, 60), ImGuiInputTextFlags_CharsNoBlank))
+					draftConfig.whitelistAppsSet = multilineStringToSet(whitelistApps);
+				addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_whitelisted_apps));
+				if (ImGui::Button(LanguageManager::getInstance().translate(Str::Whitelist_current_app), ImVec2(164, 26)))
 				{
 					std::string appKey = getCurrentApplicationKey();
-					if (!isApplicationWhitelisted(appKey))
+					if (appKey != "" && !draftConfig.whitelistAppsSet.count(appKey))
 					{
-						whitelistAppsSet.insert(appKey);
+						draftConfig.whitelistAppsSet.insert(appKey);
 						if (whitelistApps != "")
 							whitelistApps += "\n";
 						whitelistApps += appKey;
 					}
 				}
-				addTooltip(LanguageManager::getInstance().translate("Tooltip_whitelisted_current_app").c_str());
+				addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_whitelisted_current_app));
 			}
 
-    if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("Resolution").c_str()))
+	if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::App_profile)))
+	{
+		addTooltip(LanguageManager::getInstance().translate(Str::Tooltip_app_profile));
+		drawAppProfileEditor();
+	}
+
+    if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::Resolution)))
     {
-        if (ImGui::InputInt(LanguageManager::getInstance().translate("Initial_resolution").c_str(), &initialRes, 5))
-            initialRes = std::clamp(initialRes, 20, 500);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_initial_resolution").c_str());
+        drawSetting("initialRes");
 
-        if (ImGui::InputInt(LanguageManager::getInstance().translate("Minimum_resolution").c_str(), &minRes, 5))
-            minRes = std::clamp(minRes, 20, 500);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_minimum_resolution").c_str());
+        drawSetting("minRes");
 
-        if (ImGui::InputInt(LanguageManager::getInstance().translate("Maximum_resolution").c_str(), &maxRes, 5))
-            maxRes = std::clamp(maxRes, 20, 500);
-        addTooltip(LanguageManager::getInstance().translate("Tooltip_maximum_resolution").c_str());
+        drawSetting("maxRes");
 
-        if (ImGui::TreeNodeEx(LanguageManager::getInstance().translate("Advanced").c_str(), ImGuiTreeNodeFlags_NoTreePushOnOpen))
+        if (ImGui::TreeNodeEx(LanguageManager::getInstance().translate(Str::Advanced), ImGuiTreeNodeFlags_NoTreePushOnOpen))
         {
-            if (ImGui::InputInt(LanguageManager::getInstance().translate("Increase_threshold").c_str(), &resIncreaseThresholdFPS, 1))
-                resIncreaseThresholdFPS = std::clamp(resIncreaseThresholdFPS, std::max(resDecreaseThresholdFPS, 10), hmdHz);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_increase_threshold").c_str());
+            if (drawSetting("resIncreaseThresholdFPS"))
+                draftConfig.resIncreaseThresholdFPS = std::clamp(draftConfig.resIncreaseThresholdFPS, std::max(draftConfig.resDecreaseThresholdFPS, 10), hmdHz);
+
+            if (drawSetting("resDecreaseThresholdFPS"))
+                draftConfig.resDecreaseThresholdFPS = std::clamp(draftConfig.resDecreaseThresholdFPS, 10, std::min(draftConfig.resIncreaseThresholdFPS, hmdHz));
+
+            drawSetting("resIncreaseMin");
+
+            drawSetting("resDecreaseMin");
+
+            drawSetting("resIncreaseScale");
+
+            drawSetting("resDecreaseScale");
+
+            drawSetting("minCpuTimeThreshold");
+
+            drawSetting("resetOnThreshold");
 
-            if (ImGui::InputInt(LanguageManager::getInstance().translate("Decrease_threshold").c_str(), &resDecreaseThresholdFPS, 1))
-                resDecreaseThresholdFPS = std::clamp(resDecreaseThresholdFPS, 10, std::min(resIncreaseThresholdFPS, hmdHz));
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_decrease_threshold").c_str());
+            drawSetting("pauseOnLoading");
 
-            ImGui::InputInt(LanguageManager::getInstance().translate("Increase_minimum").c_str(), &resIncreaseMin, 1);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_increase_minimum").c_str());
+            drawSetting("transitionDetection");
 
-            ImGui::InputInt(LanguageManager::getInstance().translate("Decrease_minimum").c_str(), &resDecreaseMin, 1);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_decrease_minimum").c_str());
+            drawSetting("transitionHoldMs");
 
-            ImGui::InputInt(LanguageManager::getInstance().translate("Increase_scale").c_str(), &resIncreaseScale, 10);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_increase_scale").c_str());
+            drawSetting("jitterLimitEnabled");
 
-            ImGui::InputInt(LanguageManager::getInstance().translate("Decrease_scale").c_str(), &resDecreaseScale, 10);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_decrease_scale").c_str());
+            drawSetting("jitterThresholdMs");
 
-            ImGui::InputFloat(LanguageManager::getInstance().translate("Minimum_CPU_time_threshold").c_str(), &minCpuTimeThreshold, 0.1);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_minimum_CPU_time_threshold").c_str());
+            drawSetting("renderTargetSnap");
+            ImGui::SameLine();
+            ImGui::RadioButton("16 px", &draftConfig.renderTargetTile, 16);
+            ImGui::SameLine();
+            ImGui::RadioButton("32 px", &draftConfig.renderTargetTile, 32);
+            ImGui::SameLine();
+            ImGui::RadioButton("64 px", &draftConfig.renderTargetTile, 64);
 
-            ImGui::Checkbox(LanguageManager::getInstance().translate("Reset_on_CPU_time_threshold").c_str(), &resetOnThreshold);
-            addTooltip(LanguageManager::getInstance().translate("Tooltip_reset_on_CPU_time_threshold").c_str());
+            drawSetting("hysteresisEnabled");
+
+            drawSetting("increaseConfidence");
+
+            drawSetting("decreaseConfidence");
+
+            drawSetting("probeDwellMs");
+
+            drawSetting("cooldownMs");
         }
     }
-		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("header_reprojection").c_str()))
+		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::header_reprojection)))
 		{
-			ImGui::Checkbox(LanguageManager::getInstance().translate("Always_reproject").c_str(), &alwaysReproject);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_always_reproject").c_str());
+			drawSetting("alwaysReproject");
+
+			drawSetting("preferReprojection");
+
+			drawSetting("ignoreCpuTime");
+
+			drawSetting("reprojectionReasonAware");
+
+			drawSetting("subtractCompositorGpu");
 
-			ImGui::Checkbox(LanguageManager::getInstance().translate("Prefer_reprojection").c_str(), &preferReprojection);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_prefer_reprojection").c_str());
+			drawSetting("refreshRateEnabled");
 
-			ImGui::Checkbox(LanguageManager::getInstance().translate("Ignore_CPU_time").c_str(), &ignoreCpuTime);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_ignore_CPU_time").c_str());
+			if (drawSetting("refreshRateResFloor"))
+				draftConfig.refreshRateResFloor = std::clamp(draftConfig.refreshRateResFloor, draftConfig.minRes, draftConfig.maxRes);
+
+			drawSetting("refreshRateDwellMs");
+		}
+
+		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::CPU)))
+		{
+			drawSetting("cpuMonitorEnabled");
+
+			drawSetting("cpuBoundThreshold");
 		}
 
-		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("VRAM").c_str()))
+		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::VRAM)))
 		{
-			ImGui::Checkbox(LanguageManager::getInstance().translate("VRAM_monitor_enabled").c_str(), &vramMonitorEnabled);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_vram_monitor").c_str());
+			drawSetting("vramMonitorEnabled");
+
+			drawSetting("vramOnlyMode");
 
-			ImGui::Checkbox(LanguageManager::getInstance().translate("VRAM-only_mode").c_str(), &vramOnlyMode);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_VRAM-only_mode").c_str());
+			drawSetting("vramTarget");
 
-			if (ImGui::InputInt(LanguageManager::getInstance().translate("VRAM_target").c_str(), &vramTarget, 2))
-				vramTarget = std::clamp(vramTarget, 0, 100);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_vram_target").c_str());
+			drawSetting("vramLimit");
 
-			if (ImGui::InputInt(LanguageManager::getInstance().translate("VRAM_limit").c_str(), &vramLimit, 2))
-				vramLimit = std::clamp(vramLimit, 0, 100);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_vram_limit").c_str());
+			drawSetting("vramForecastEnabled");
+
+			drawSetting("vramForecastSeconds");
 		}
 
-		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("RAM").c_str()))
+		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::RAM)))
 		{
-			ImGui::Checkbox(LanguageManager::getInstance().translate("RAM_monitor_enabled").c_str(), &ramMonitorEnabled);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_ram_monitor").c_str());
+			drawSetting("ramMonitorEnabled");
 
-			if (ImGui::InputInt(LanguageManager::getInstance().translate("RAM_limit").c_str(), &ramLimit, 2))
-				ramLimit = std::clamp(ramLimit, 0, 100);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_ram_limit").c_str());
+			drawSetting("ramLimit");
 		}
 
-		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate("GPU_usage_b").c_str()))
+		if (ImGui::CollapsingHeader(LanguageManager::getInstance().translate(Str::GPU_usage_b)))
 		{
-			ImGui::Checkbox(LanguageManager::getInstance().translate("GPU_usage_enabled").c_str(), &GPUusageEnabled);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_GPU_usage_enabled").c_str());
+			drawSetting("GPUusageEnabled");
 
-			if (ImGui::InputInt(LanguageManager::getInstance().translate("GPU_usage_target").c_str(), &GPUusageTarget, 2))
-				GPUusageTarget = std::clamp(GPUusageTarget, 10, 100);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_GPU_usage_target").c_str());
+			drawSetting("GPUusageTarget");
 
-			if (ImGui::InputInt(LanguageManager::getInstance().translate("GPU_usage_limit").c_str(), &GPUusageLimit, 2))
-				GPUusageLimit = std::clamp(GPUusageLimit, 10, 100);
-			addTooltip(LanguageManager::getInstance().translate("Tooltip_GPU_usage_limit").c_str());
+			drawSetting("GPUusageLimit");
 		}
 
 
     // Buttons
-    bool closePressed = ImGui::Button(LanguageManager::getInstance().translate("Close").c_str(), ImVec2(82, 28));
+    bool closePressed = ImGui::Button(LanguageManager::getInstance().translate(Str::Close), ImVec2(82, 28));
     if (closePressed)
     {
         showSettings = false;
     }
     ImGui::SameLine();
     pushRedButtonColour();
-    bool revertPressed = ImGui::Button(LanguageManager::getInstance().translate("Revert").c_str(), ImVec2(82, 28));
+    bool revertPressed = ImGui::Button(LanguageManager::getInstance().translate(Str::Revert), ImVec2(82, 28));
     if (revertPressed)
     {
-        int oldDataAverageSamples = dataAverageSamples;
         loadSettings();
-        if (oldDataAverageSamples != dataAverageSamples)
-            frameTiming = new vr::Compositor_FrameTiming[dataAverageSamples];
+        setLanguage(draftConfig.languageIndex);
     }
     ImGui::SameLine();
     pushGreenButtonColour();
-    bool savePressed = ImGui::Button(LanguageManager::getInstance().translate("Save").c_str(), ImVec2(82, 28));
+    bool savePressed = ImGui::Button(LanguageManager::getInstance().translate(Str::Save), ImVec2(82, 28));
     if (savePressed)
     {
         saveSettings();
-        if (prevAutoStart != autoStart)
+        if (prevAutoStart != draftConfig.autoStart)
         {
-            handle_setup(autoStart);
-            prevAutoStart = autoStart;
+            handle_setup(draftConfig.autoStart);
+            prevAutoStart = draftConfig.autoStart;
         }
     }
 
@@ -1132,39 +1984,28 @@ if (showSettings)
 }
 #pragma endregion
 
+		// Hand the edited settings to the controller, it picks them up next iteration
+		publishDraftConfig();
+
 		// Rendering
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
 		glfwSwapBuffers(glfwWindow);
-#pragma endregion
-
-		// Check if OpenVR is quitting so we can quit alongside it
-		VREvent_t vrEvent;
-		while (vr::VRSystem()->PollNextEvent(&vrEvent, sizeof(vr::VREvent_t)))
-		{
-			if (vrEvent.eventType == vr::VREvent_Quit)
-			{
-				vr::VRSystem()->AcknowledgeQuit_Exiting();
-				openvrQuit = true;
-				break;
-			}
-		}
-
-		// Calculate how long to sleep for depending on if the window is focused or not.
-		std::chrono::milliseconds sleepTime;
-		if (glfwGetWindowAttrib(glfwWindow, GLFW_FOCUSED))
-			sleepTime = refreshIntervalFocused;
-		else
-			sleepTime = refreshIntervalBackground;
 
-		// ZZzzzz
-		std::this_thread::sleep_for(sleepTime);
+		// Keep drawing while text is edited (the cursor blinks) or something is dragged
+		guiActive = ImGui::GetIO().WantTextInput || ImGui::IsAnyItemActive();
+#pragma endregion
 	}
 
 	// OpenVR cleanup
+	restorePreferredRefreshRate(refreshRatePolicy);
 	vr::VR_Shutdown();
 	cleanupGPU();
+	closeTrace();
+	closeFrameTrace();
+	stopFileWatcher();
+	stopSettingsWriter();
 	cleanup();
 
 #if defined(_WIN32)
@@ -0,0 +1,84 @@
+#include "refresh_rate.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <openvr.h>
+
+// Rates closer than this are the same rate (e.g. 119.99 and 120)
+static constexpr const float rateTolerance = 0.5f;
+
+bool loadAvailableRefreshRates(RefreshRatePolicy &policy)
+{
+	float rates[32];
+	vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+	uint32_t bytes = vr::VRSystem()->GetArrayTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayAvailableFrameRates_Float_Array,
+																	vr::k_unFloatPropertyTag, rates, sizeof(rates), &error);
+	policy.rates.clear();
+	if (error != vr::TrackedProp_Success)
+		return false;
+
+	policy.rates.assign(rates, rates + bytes / sizeof(float));
+	std::sort(policy.rates.begin(), policy.rates.end());
+	return policy.rates.size() > 1;
+}
+
+float getNeighbourRefreshRate(const RefreshRatePolicy &policy, float currentHz, int direction)
+{
+	if (direction < 0)
+	{
+		for (auto it = policy.rates.rbegin(); it != policy.rates.rend(); ++it)
+			if (*it < currentHz - rateTolerance)
+				return *it;
+	}
+	else
+	{
+		for (float rate : policy.rates)
+			if (rate > currentHz + rateTolerance)
+				return rate;
+	}
+	return 0;
+}
+
+float updateRefreshRatePolicy(RefreshRatePolicy &policy, const RefreshRateConfig &config, float currentHz,
+							  bool overBudgetAtFloor, float frametimeMs, long long nowMs)
+{
+	float lower = getNeighbourRefreshRate(policy, currentHz, -1);
+	float higher = getNeighbourRefreshRate(policy, currentHz, 1);
+
+	// Step up once the frames would fit in the higher rate's frametime with some margin
+	bool headroom = higher > 0 && frametimeMs > 0 && frametimeMs < 1000.0f / higher * config.headroom;
+	policy.downStreak = overBudgetAtFloor && lower > 0 ? policy.downStreak + 1 : 0;
+	policy.upStreak = headroom && !overBudgetAtFloor ? policy.upStreak + 1 : 0;
+
+	if (policy.lastSwitchMs >= 0 && nowMs - policy.lastSwitchMs < config.dwellMs)
+		return 0;
+
+	float rate = 0;
+	if (policy.downStreak >= config.confidence)
+		rate = lower;
+	else if (policy.upStreak >= config.confidence)
+		rate = higher;
+	if (rate > 0)
+	{
+		policy.downStreak = 0;
+		policy.upStreak = 0;
+		policy.lastSwitchMs = nowMs;
+		policy.switches++;
+	}
+	return rate;
+}
+
+void setPreferredRefreshRate(RefreshRatePolicy &policy, float hz)
+{
+	if (policy.switches > 0 && policy.originalRate == 0)
+		policy.originalRate = vr::VRSettings()->GetInt32(vr::k_pch_SteamVR_Section, k_pch_SteamVR_PreferredRefreshRate_Int32);
+	vr::VRSettings()->SetInt32(vr::k_pch_SteamVR_Section, k_pch_SteamVR_PreferredRefreshRate_Int32, (int32_t)std::lround(hz));
+}
+
+void restorePreferredRefreshRate(RefreshRatePolicy &policy)
+{
+	if (policy.originalRate > 0)
+		vr::VRSettings()->SetInt32(vr::k_pch_SteamVR_Section, k_pch_SteamVR_PreferredRefreshRate_Int32, policy.originalRate);
+	policy.originalRate = 0;
+}
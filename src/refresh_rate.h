@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+/// SteamVR setting (in the steamvr section) holding the refresh rate the headset should run at
+static constexpr const char *k_pch_SteamVR_PreferredRefreshRate_Int32 = "preferredRefreshRate";
+
+struct RefreshRateConfig
+{
+	int confidence = 3;		// Consecutive decisions agreeing before switching
+	int dwellMs = 20000;	// Minimum time between two switches
+	float headroom = 0.8f;	// Share of the higher rate's frametime the frames must fit in to step up
+};
+
+/// Manages the HMD refresh rate as a second knob next to the resolution
+struct RefreshRatePolicy
+{
+	std::vector<float> rates; // Rates the HMD supports, ascending
+	int downStreak = 0;
+	int upStreak = 0;
+	long long lastSwitchMs = -1;
+	int switches = 0;
+	int originalRate = 0; // Preferred rate before the first switch, restored on exit
+};
+
+/// Reads the refresh rates the HMD supports, false if it doesn't report them
+bool loadAvailableRefreshRates(RefreshRatePolicy &policy);
+
+/// Supported rate just below (direction < 0) or above (direction > 0) currentHz, or 0 if there is none
+float getNeighbourRefreshRate(const RefreshRatePolicy &policy, float currentHz, int direction);
+
+/**
+ * Advances the policy by one decision and returns the rate to switch to, or 0 to stay.
+ * overBudgetAtFloor: the resolution would drop below the quality floor and frames are still late.
+ * frametimeMs: the larger of the GPU and CPU frametimes.
+ */
+float updateRefreshRatePolicy(RefreshRatePolicy &policy, const RefreshRateConfig &config, float currentHz,
+							  bool overBudgetAtFloor, float frametimeMs, long long nowMs);
+
+/// Asks SteamVR to run the HMD at hz
+void setPreferredRefreshRate(RefreshRatePolicy &policy, float hz);
+
+/// Puts back the preferred rate from before the first switch
+void restorePreferredRefreshRate(RefreshRatePolicy &policy);
@@ -0,0 +1,61 @@
+#include "render_target.h"
+
+#include <algorithm>
+#include <cmath>
+
+RenderTargetSize getRenderTargetSize(uint32_t width, uint32_t height, float currentRes, float res)
+{
+	RenderTargetSize size;
+	if (currentRes <= 0 || res <= 0)
+		return size;
+	double scale = std::sqrt((double)res / currentRes);
+	size.width = (uint32_t)std::lround(width * scale);
+	size.height = (uint32_t)std::lround(height * scale);
+	return size;
+}
+
+/// Percent at which the dimension size (size at currentRes) scaled to the highest multiple of tile not above target, 0 if none
+static double alignedDimensionRes(uint32_t size, uint32_t target, float currentRes, int tile)
+{
+	uint32_t aligned = target / tile * tile;
+	if (aligned == 0)
+		return 0;
+	double res = std::pow((double)aligned / size, 2) * currentRes;
+	// Rounding can land a pixel off, nudge it until the dimension SteamVR computes is the aligned one
+	for (int i = 0; i < 4; i++)
+	{
+		uint32_t scaled = (uint32_t)std::lround(size * std::sqrt(res / currentRes));
+		if (scaled == aligned)
+			return res;
+		res = std::nextafter((float)res, scaled > aligned ? 0.0f : INFINITY);
+	}
+	return 0;
+}
+
+float snapResToTiles(float res, float lastRes, uint32_t width, uint32_t height, float currentRes, int tile)
+{
+	if (width == 0 || height == 0 || currentRes <= 0 || tile <= 0)
+		return res;
+	// Holding, lastRes may itself be a snapped fraction of a percent
+	if (std::round(res) == std::round(lastRes))
+		return lastRes;
+
+	// Highest percent not above res at which the width or the height is a whole number of tiles.
+	// Both rarely can be, the aspect ratio of the render target isn't one of the tile grid.
+	RenderTargetSize proposed = getRenderTargetSize(width, height, currentRes, res);
+	double widthRes = alignedDimensionRes(width, proposed.width, currentRes, tile);
+	double heightRes = alignedDimensionRes(height, proposed.height, currentRes, tile);
+	float snapped = (float)std::max(widthRes, heightRes);
+	if (snapped <= 0)
+		return res;
+
+	// A change that doesn't change the pixel count only costs a hitch
+	RenderTargetSize last = getRenderTargetSize(width, height, currentRes, lastRes);
+	RenderTargetSize next = getRenderTargetSize(width, height, currentRes, snapped);
+	if (next.width == last.width && next.height == last.height)
+		return lastRes;
+	// Don't turn an increase into a decrease or the opposite
+	if ((res > lastRes && snapped < lastRes) || (res < lastRes && snapped > lastRes))
+		return lastRes;
+	return snapped;
+}
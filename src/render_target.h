@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+/// Per-eye render target dimensions
+struct RenderTargetSize
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
+
+/**
+ * Render target SteamVR would use at res, from the recommended size (width x height) at currentRes.
+ * The resolution percent scales the pixel count, so each dimension scales with its square root.
+ */
+RenderTargetSize getRenderTargetSize(uint32_t width, uint32_t height, float currentRes, float res);
+
+/**
+ * Snaps res down to the highest resolution (not a whole percent) at which the width or the height
+ * of the render target is a whole number of tile pixel tiles. Only one of them is aligned,
+ * the aspect ratio rarely allows both.
+ * Returns lastRes if res rounds to it or if the render target wouldn't change.
+ */
+float snapResToTiles(float res, float lastRes, uint32_t width, uint32_t height, float currentRes, int tile);
@@ -0,0 +1,144 @@
+#include "res_change_cost.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+// A change has settled once frametimes stayed stable for this long
+static constexpr const double settledDurationS = 0.5;
+// Give up and record the worst case after this long
+static constexpr const double settleTimeoutS = 5.0;
+// Weight of a new measurement in the smoothed cost
+static constexpr const float costSmoothing = 0.3f;
+// Frametime variation still considered stable
+static constexpr const float stableToleranceMs = 0.5f;
+static constexpr const float stableTolerance = 0.15f;
+
+static std::unordered_map<std::string, ResChangeCost> resChangeCosts;
+
+// Pending measurement
+static bool measuring = false;
+static std::string measuredAppKey;
+static uint32_t lastSeenFrameIndex = 0;
+static float expectedGpuMs = 0;
+static double changeTimeS = -1;
+static double stableSinceS = -1;
+static float stableMeanMs = 0;
+static float stableIntervalMs = 0;
+static double previousFrameTimeS = -1;
+static int stableFrames = 0;
+static float worstSpikeMs = 0;
+
+static void finishSettleMeasurement(double settleS)
+{
+	ResChangeCost &cost = resChangeCosts[measuredAppKey];
+	float settleMs = (float)(settleS * 1000.0);
+	if (cost.measurements == 0)
+	{
+		cost.settleMs = settleMs;
+		cost.spikeMs = worstSpikeMs;
+	}
+	else
+	{
+		cost.settleMs += (settleMs - cost.settleMs) * costSmoothing;
+		cost.spikeMs += (worstSpikeMs - cost.spikeMs) * costSmoothing;
+	}
+	cost.measurements++;
+	measuring = false;
+}
+
+void beginSettleMeasurement(const std::string &appKey, uint32_t lastFrameIndex, float baselineGpuMs, float resRatio)
+{
+	measuring = true;
+	measuredAppKey = appKey;
+	lastSeenFrameIndex = lastFrameIndex;
+	// GPU frametime roughly scales with the pixel count
+	expectedGpuMs = baselineGpuMs * resRatio;
+	changeTimeS = -1;
+	stableSinceS = -1;
+	stableMeanMs = 0;
+	stableIntervalMs = 0;
+	previousFrameTimeS = -1;
+	stableFrames = 0;
+	worstSpikeMs = 0;
+}
+
+bool isSettleMeasurementPending()
+{
+	return measuring;
+}
+
+void updateSettleMeasurement(const vr::Compositor_FrameTiming *frames, int count)
+{
+	for (int i = 0; i < count && measuring; i++)
+	{
+		const vr::Compositor_FrameTiming &frame = frames[i];
+		if (frame.m_nFrameIndex <= lastSeenFrameIndex)
+			continue;
+		lastSeenFrameIndex = frame.m_nFrameIndex;
+
+		double time = frame.m_flSystemTimeInSeconds;
+		float gpuTime = frame.m_flTotalRenderGpuMs;
+		if (changeTimeS < 0)
+			changeTimeS = time;
+		// A long gap between frames is a hitch (e.g. render targets being re-created)
+		float intervalMs = previousFrameTimeS < 0 ? 0 : (float)((time - previousFrameTimeS) * 1000.0);
+		previousFrameTimeS = time;
+
+		worstSpikeMs = std::max(worstSpikeMs, gpuTime - expectedGpuMs);
+
+		// Track runs of frames that stay close to their own running mean
+		float tolerance = std::max(stableToleranceMs, stableMeanMs * stableTolerance);
+		bool hitch = stableFrames > 1 && intervalMs > stableIntervalMs * 2 + 1;
+		if (stableFrames == 0 || std::fabs(gpuTime - stableMeanMs) > tolerance || hitch)
+		{
+			stableSinceS = time;
+			stableMeanMs = gpuTime;
+			stableIntervalMs = 0;
+			stableFrames = 1;
+		}
+		else
+		{
+			stableFrames++;
+			stableMeanMs += (gpuTime - stableMeanMs) / stableFrames;
+			stableIntervalMs += (intervalMs - stableIntervalMs) / (stableFrames - 1);
+		}
+
+		if (time - stableSinceS >= settledDurationS)
+			finishSettleMeasurement(stableSinceS - changeTimeS);
+		else if (time - changeTimeS >= settleTimeoutS)
+			finishSettleMeasurement(settleTimeoutS);
+	}
+}
+
+const ResChangeCost *getResChangeCost(const std::string &appKey)
+{
+	auto it = resChangeCosts.find(appKey);
+	if (it == resChangeCosts.end())
+		return nullptr;
+	return &it->second;
+}
+
+int getAdaptiveResChangeDelayMs(const std::string &appKey, int baseDelayMs, int minDelayMs, int maxDelayMs)
+{
+	const ResChangeCost *cost = getResChangeCost(appKey);
+	if (!cost)
+		return baseDelayMs;
+
+	// Leave a few settle times between decisions so the averages are made of settled frames
+	int delayMs = (int)(cost->settleMs * 4) + 500;
+	return std::clamp(delayMs, minDelayMs, std::max(minDelayMs, maxDelayMs));
+}
+
+int getAdaptiveResChangeMin(const std::string &appKey, int baseMin, float frameBudgetMs)
+{
+	const ResChangeCost *cost = getResChangeCost(appKey);
+	if (!cost)
+		return baseMin;
+
+	// Don't pay a long hitch for a tiny change: up to 3x the step for apps taking a second to settle
+	float settleFactor = std::clamp(cost->settleMs / 333.0f, 1.0f, 3.0f);
+	// and up to 2x more when the spike costs whole frames (a spike of one budget misses a frame)
+	float spikeFactor = frameBudgetMs > 0 ? std::clamp(1.0f + cost->spikeMs / frameBudgetMs, 1.0f, 2.0f) : 1.0f;
+	return (int)std::round(baseMin * settleFactor * spikeFactor);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <openvr.h>
+
+/**
+ * Measured cost of a resolution change for one application.
+ * Some apps re-create their render targets in a few frames, others
+ * hitch for a second after every SupersampleScale write.
+ */
+struct ResChangeCost
+{
+	float settleMs = 0;	  // Time for frametimes to stabilise after a change (smoothed)
+	float spikeMs = 0;	  // Worst GPU frametime excess while settling (smoothed)
+	int measurements = 0; // Number of changes measured
+};
+
+/**
+ * Starts measuring the change that was just applied.
+ * lastFrameIndex is the newest frame rendered before the change,
+ * baselineGpuMs the average GPU frametime before it and
+ * resRatio the new resolution divided by the old one.
+ */
+void beginSettleMeasurement(const std::string &appKey, uint32_t lastFrameIndex, float baselineGpuMs, float resRatio);
+
+/// Whether a change is still being measured
+bool isSettleMeasurementPending();
+
+/// Feeds the latest frame timings (oldest first) to the pending measurement
+void updateSettleMeasurement(const vr::Compositor_FrameTiming *frames, int count);
+
+/// Returns the measured cost for appKey, or nullptr if none was measured yet
+const ResChangeCost *getResChangeCost(const std::string &appKey);
+
+/// Delay between resolution decisions for appKey, scaled to its settle time
+int getAdaptiveResChangeDelayMs(const std::string &appKey, int baseDelayMs, int minDelayMs, int maxDelayMs);
+
+/**
+ * Minimum resolution step for appKey, larger for apps that are expensive to change:
+ * long to settle, or with a GPU spike that's large next to frameBudgetMs.
+ */
+int getAdaptiveResChangeMin(const std::string &appKey, int baseMin, float frameBudgetMs);
@@ -0,0 +1,145 @@
+#include "res_state.h"
+
+#include <algorithm>
+
+static void setResState(ResStateMachine &machine, ResState state, long long nowMs)
+{
+	if (state == machine.state)
+		return;
+	machine.transitions[(int)machine.state][(int)state]++;
+	machine.state = state;
+	machine.stateSinceMs = nowMs;
+}
+
+float updateResStateMachine(ResStateMachine &machine, const ResStateConfig &config, ResIntent intent,
+							float currentRes, float proposedRes, long long nowMs)
+{
+	if (machine.startMs < 0)
+	{
+		machine.startMs = nowMs;
+		machine.stateSinceMs = nowMs;
+		machine.lastKnownGoodRes = currentRes;
+	}
+
+	// Count agreeing decisions in a row
+	machine.increaseStreak = intent == ResIntent::Increase ? machine.increaseStreak + 1 : 0;
+	machine.decreaseStreak = intent == ResIntent::Decrease ? machine.decreaseStreak + 1 : 0;
+	bool confidentIncrease = machine.increaseStreak >= config.increaseConfidence;
+	bool confidentDecrease = machine.decreaseStreak >= config.decreaseConfidence;
+	long long inStateMs = nowMs - machine.stateSinceMs;
+
+	float res = currentRes;
+	switch (machine.state)
+	{
+	case ResState::Stable:
+		if (confidentDecrease)
+		{
+			machine.lastKnownGoodRes = proposedRes;
+			setResState(machine, ResState::BackingOff, nowMs);
+			res = proposedRes;
+		}
+		else if (confidentIncrease)
+		{
+			machine.lastKnownGoodRes = currentRes;
+			setResState(machine, ResState::ProbingUp, nowMs);
+			res = proposedRes;
+		}
+		break;
+
+	case ResState::ProbingUp:
+		if (intent == ResIntent::Decrease)
+		{
+			// The probe failed, go back to what worked (or lower if even that is too much now)
+			machine.failedProbes++;
+			res = std::min(machine.lastKnownGoodRes, proposedRes);
+			setResState(machine, ResState::Cooldown, nowMs);
+		}
+		else if (inStateMs >= config.probeDwellMs)
+		{
+			// The probe held, keep going up if there's still headroom
+			machine.lastKnownGoodRes = currentRes;
+			if (confidentIncrease)
+			{
+				machine.stateSinceMs = nowMs;
+				res = proposedRes;
+			}
+			else
+			{
+				setResState(machine, ResState::Stable, nowMs);
+			}
+		}
+		break;
+
+	case ResState::BackingOff:
+		if (intent == ResIntent::Decrease)
+		{
+			machine.lastKnownGoodRes = proposedRes;
+			res = proposedRes;
+		}
+		else
+		{
+			setResState(machine, ResState::Cooldown, nowMs);
+		}
+		break;
+
+	case ResState::Cooldown:
+		if (confidentDecrease)
+		{
+			machine.lastKnownGoodRes = proposedRes;
+			setResState(machine, ResState::BackingOff, nowMs);
+			res = proposedRes;
+		}
+		else if (inStateMs >= config.cooldownMs)
+		{
+			setResState(machine, ResState::Stable, nowMs);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (res != currentRes)
+		machine.resChanges++;
+	return res;
+}
+
+void resetResStateMachine(ResStateMachine &machine, float currentRes, long long nowMs)
+{
+	setResState(machine, ResState::Stable, nowMs);
+	machine.increaseStreak = 0;
+	machine.decreaseStreak = 0;
+	machine.lastKnownGoodRes = currentRes;
+}
+
+float getResChangesPerHour(const ResStateMachine &machine, long long nowMs)
+{
+	if (machine.startMs < 0 || nowMs <= machine.startMs)
+		return 0;
+	return machine.resChanges * 3600000.0f / (float)(nowMs - machine.startMs);
+}
+
+int getResStateEntries(const ResStateMachine &machine, ResState state)
+{
+	int entries = 0;
+	for (int from = 0; from < (int)ResState::Count; from++)
+		entries += machine.transitions[from][(int)state];
+	return entries;
+}
+
+Str resStateTranslationKey(ResState state)
+{
+	switch (state)
+	{
+	case ResState::Stable:
+		return Str::Res_state_stable;
+	case ResState::ProbingUp:
+		return Str::Res_state_probing_up;
+	case ResState::BackingOff:
+		return Str::Res_state_backing_off;
+	case ResState::Cooldown:
+		return Str::Res_state_cooldown;
+	default:
+		return Str::None;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "translations.h"
+
+/**
+ * Hysteresis state machine sitting between the raw increase/decrease
+ * decision and the resolution that actually gets applied, so the
+ * resolution doesn't flip back and forth around the thresholds.
+ *
+ * Stable:     holding; an increase needs several agreeing decisions, a decrease fewer.
+ * ProbingUp:  the resolution was raised; if it has to come down again
+ *             the probe failed and we fall back to the last known good resolution.
+ * BackingOff: decreasing for as long as it's needed.
+ * Cooldown:   no increases for a while after backing off or a failed probe.
+ */
+enum class ResState
+{
+	Stable,
+	ProbingUp,
+	BackingOff,
+	Cooldown,
+	Count
+};
+
+/// What the raw controller wants to do this decision
+enum class ResIntent
+{
+	Hold,
+	Increase,
+	Decrease
+};
+
+struct ResStateConfig
+{
+	int increaseConfidence = 2; // Consecutive increase decisions needed to probe up
+	int decreaseConfidence = 1; // Consecutive decrease decisions needed to back off
+	int probeDwellMs = 2000;	// Time a probe must hold before it becomes the last known good resolution
+	int cooldownMs = 15000;		// Time without increases after backing off
+};
+
+struct ResStateMachine
+{
+	ResState state = ResState::Stable;
+	long long stateSinceMs = 0;
+	int increaseStreak = 0;
+	int decreaseStreak = 0;
+	float lastKnownGoodRes = 0;
+
+	// Diagnostics
+	long long startMs = -1;
+	int resChanges = 0;
+	int failedProbes = 0;
+	int transitions[(int)ResState::Count][(int)ResState::Count] = {};
+};
+
+/**
+ * Advances the state machine by one decision and returns the resolution to apply.
+ * proposedRes is what the raw controller computed from currentRes.
+ */
+float updateResStateMachine(ResStateMachine &machine, const ResStateConfig &config, ResIntent intent,
+							float currentRes, float proposedRes, long long nowMs);
+
+/// Goes back to Stable, e.g. when the resolution is reset or changed by the user
+void resetResStateMachine(ResStateMachine &machine, float currentRes, long long nowMs);
+
+/// Resolution changes per hour since the first decision
+float getResChangesPerHour(const ResStateMachine &machine, long long nowMs);
+
+/// Number of times the machine entered state
+int getResStateEntries(const ResStateMachine &machine, ResState state);
+
+/// Translation of the name of state
+Str resStateTranslationKey(ResState state);
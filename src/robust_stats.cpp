@@ -0,0 +1,90 @@
+#include "robust_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+// MAD of normally distributed samples times this is their standard deviation
+static constexpr const float madToStdDev = 1.4826f;
+// Samples further than this many deviations from the median are clipped
+static constexpr const float clipDeviations = 3.0f;
+// Samples further than this many deviations above the median are spikes
+static constexpr const float spikeDeviations = 5.0f;
+// Share of the samples dropped at each end by the trimmed mean
+static constexpr const float trimFraction = 0.1f;
+
+static float median(std::vector<float> &samples, int count)
+{
+	int middle = count / 2;
+	std::nth_element(samples.begin(), samples.begin() + middle, samples.begin() + count);
+	float upper = samples[middle];
+	if (count % 2)
+		return upper;
+	float lower = *std::max_element(samples.begin(), samples.begin() + middle);
+	return (lower + upper) / 2;
+}
+
+void robustAverage(const float *values, const float *weights, int count, RobustEstimator estimator,
+				   std::vector<float> &scratch, RobustAverage &average)
+{
+	average = RobustAverage();
+	if (count <= 0)
+		return;
+
+	if (scratch.size() < (size_t)count)
+		scratch.resize(count);
+
+	// Median and MAD are wanted for spike detection whatever the estimator
+	std::copy(values, values + count, scratch.begin());
+	average.median = median(scratch, count);
+	for (int i = 0; i < count; i++)
+		scratch[i] = std::fabs(values[i] - average.median);
+	// Identical samples would give a spread of 0, flagging any change as an outlier
+	average.spread = std::max(median(scratch, count) * madToStdDev, average.median * 0.01f);
+
+	// Samples outside [low, high] are clipped (MAD) or dropped (trimmed mean)
+	float low = -INFINITY;
+	float high = INFINITY;
+	if (estimator == RobustEstimator::MedianMad)
+	{
+		low = average.median - average.spread * clipDeviations;
+		high = average.median + average.spread * clipDeviations;
+	}
+	else if (estimator == RobustEstimator::TrimmedMean)
+	{
+		int trimmed = (int)(count * trimFraction);
+		if (trimmed > 0)
+		{
+			std::copy(values, values + count, scratch.begin());
+			std::nth_element(scratch.begin(), scratch.begin() + trimmed, scratch.begin() + count);
+			low = scratch[trimmed];
+			std::nth_element(scratch.begin(), scratch.begin() + count - 1 - trimmed, scratch.begin() + count);
+			high = scratch[count - 1 - trimmed];
+		}
+	}
+
+	float total = 0;
+	float totalWeight = 0;
+	for (int i = 0; i < count; i++)
+	{
+		float value = values[i];
+		float weight = weights ? weights[i] : 1.0f;
+		if (value < low || value > high)
+		{
+			average.outliers++;
+			if (estimator == RobustEstimator::TrimmedMean)
+				continue;
+			value = std::clamp(value, low, high);
+		}
+		total += value * weight;
+		totalWeight += weight;
+	}
+	average.mean = totalWeight > 0 ? total / totalWeight : average.median;
+}
+
+bool isIsolatedSpike(const float *values, int count, int index, const RobustAverage &average, float minExcess)
+{
+	float threshold = average.median + std::max(average.spread * spikeDeviations, minExcess);
+	auto above = [&](int i)
+	{ return i >= 0 && i < count && values[i] > threshold; };
+	return above(index) && !above(index - 1) && !above(index + 1);
+}
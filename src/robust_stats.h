@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+/// How the samples of the averaging window are combined
+enum class RobustEstimator
+{
+	Mean,		// Plain (weighted) mean
+	MedianMad,	// Mean after clipping samples far from the median, in MADs
+	TrimmedMean // Mean of the samples between the 10th and 90th percentiles
+};
+
+struct RobustAverage
+{
+	float mean = 0;	  // Average after rejecting outliers
+	float median = 0;
+	float spread = 0; // Median absolute deviation, scaled to match a standard deviation
+	int outliers = 0; // Samples clipped or trimmed
+};
+
+/**
+ * Averages count samples (a column copied out of the frame history) with the given estimator.
+ * weights can be nullptr for equal weights. scratch is reused between calls to avoid allocating.
+ */
+void robustAverage(const float *values, const float *weights, int count, RobustEstimator estimator,
+				   std::vector<float> &scratch, RobustAverage &average);
+
+/**
+ * Whether values[index] is an isolated spike: far above the median (by at least minExcess)
+ * while its neighbours aren't. Needs the median and spread from robustAverage.
+ */
+bool isIsolatedSpike(const float *values, int count, int index, const RobustAverage &average, float minExcess);
@@ -0,0 +1,257 @@
+#include "settings_schema.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <fmt/core.h>
+
+/// Splits a space or newline-delimited list of app keys
+static void parseAppList(const char *text, std::set<std::string> &apps)
+{
+	apps.clear();
+	const char *end = text + strlen(text);
+	while (text < end)
+	{
+		const char *separator = std::find_if(text, end, [](char c)
+											 { return c == ' ' || c == '\n'; });
+		if (separator > text)
+			apps.emplace(text, separator);
+		text = separator + 1;
+	}
+}
+
+/// Parses the whole of text into a setting of config, false (leaving it as it was) if it isn't a valid value
+static bool parseSettingValue(const SettingDesc &setting, const char *text, Config &config)
+{
+	const char *end = text + strlen(text);
+	switch (setting.type)
+	{
+	case SettingType::Bool:
+	{
+		if (!strcmp(text, "true") || !strcmp(text, "false"))
+		{
+			config.*setting.boolValue = text[0] == 't';
+			return true;
+		}
+		int value = 0;
+		auto [ptr, ec] = std::from_chars(text, end, value);
+		if (ec != std::errc() || ptr != end)
+			return false;
+		config.*setting.boolValue = value != 0;
+		return true;
+	}
+	case SettingType::Int:
+	{
+		int value = 0;
+		auto [ptr, ec] = std::from_chars(text, end, value);
+		if (ec != std::errc() || ptr != end)
+			return false;
+		config.*setting.intValue = value;
+		return true;
+	}
+	case SettingType::Float:
+	{
+		float value = 0;
+		auto [ptr, ec] = std::from_chars(text, end, value);
+		if (ec != std::errc() || ptr != end || !std::isfinite(value))
+			return false;
+		config.*setting.floatValue = value;
+		return true;
+	}
+	case SettingType::AppList:
+		parseAppList(text, config.*setting.appListValue);
+		return true;
+	default:
+		return false;
+	}
+}
+
+/// Whether a setting of config is outside its range
+static bool isSettingOutOfRange(const SettingDesc &setting, const Config &config)
+{
+	switch (setting.type)
+	{
+	case SettingType::Int:
+	{
+		int value = config.*setting.intValue;
+		return value < setting.min || value > setting.max;
+	}
+	case SettingType::Float:
+	{
+		float value = config.*setting.floatValue;
+		return value < (float)setting.min || value > (float)setting.max;
+	}
+	default:
+		return false;
+	}
+}
+
+const SettingDesc *findSetting(const SettingDesc *table, size_t count, const char *key)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!strcmp(table[i].key, key))
+			return &table[i];
+	}
+	return nullptr;
+}
+
+void resetSettings(const SettingDesc *table, size_t count, Config &config)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const SettingDesc &setting = table[i];
+		switch (setting.type)
+		{
+		case SettingType::Bool:
+			config.*setting.boolValue = setting.defaultValue != 0;
+			break;
+		case SettingType::Int:
+			config.*setting.intValue = (int)setting.defaultValue;
+			break;
+		case SettingType::Float:
+			config.*setting.floatValue = (float)setting.defaultValue;
+			break;
+		case SettingType::AppList:
+			parseAppList(setting.defaultApps, config.*setting.appListValue);
+			break;
+		}
+	}
+}
+
+void clampSetting(const SettingDesc &setting, Config &config)
+{
+	if (setting.type == SettingType::Int)
+	{
+		int &value = config.*setting.intValue;
+		value = std::clamp(value, (int)setting.min, (int)setting.max);
+	}
+	else if (setting.type == SettingType::Float)
+	{
+		float &value = config.*setting.floatValue;
+		value = std::clamp(value, (float)setting.min, (float)setting.max);
+	}
+}
+
+bool parseSetting(const SettingDesc &setting, const char *text, Config &config)
+{
+	if (!parseSettingValue(setting, text, config))
+		return false;
+	clampSetting(setting, config);
+	return true;
+}
+
+std::string formatSetting(const SettingDesc &setting, const Config &config)
+{
+	char buffer[32];
+	std::to_chars_result result{buffer, std::errc()};
+	switch (setting.type)
+	{
+	case SettingType::Bool:
+		result = std::to_chars(buffer, buffer + sizeof(buffer), (int)(config.*setting.boolValue));
+		break;
+	case SettingType::Int:
+		result = std::to_chars(buffer, buffer + sizeof(buffer), config.*setting.intValue);
+		break;
+	case SettingType::Float:
+		result = std::to_chars(buffer, buffer + sizeof(buffer), config.*setting.floatValue);
+		break;
+	case SettingType::AppList:
+		return appListToString(config.*setting.appListValue, ' ');
+	}
+	return std::string(buffer, result.ptr);
+}
+
+int parseSettings(const CSimpleIniA &ini, const SettingDesc *table, size_t count, Config &config)
+{
+	int invalid = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		const SettingDesc &setting = table[i];
+		const char *text = ini.GetValue(setting.section, setting.key);
+		if (!text)
+			continue; // Missing, keep the current value
+
+		if (!parseSettingValue(setting, text, config))
+		{
+			std::cout << fmt::format("Invalid value \"{}\" for {}.{}, ignoring it", text, setting.section, setting.key) << std::endl;
+			invalid++;
+		}
+		else if (isSettingOutOfRange(setting, config))
+		{
+			std::cout << fmt::format("{}.{} = {} is out of range [{}, {}], clamping", setting.section, setting.key, text, setting.min, setting.max) << std::endl;
+			clampSetting(setting, config);
+			invalid++;
+		}
+	}
+	return invalid;
+}
+
+void serializeSettings(CSimpleIniA &ini, const SettingDesc *table, size_t count, const Config &config)
+{
+	for (size_t i = 0; i < count; i++)
+		ini.SetValue(table[i].section, table[i].key, formatSetting(table[i], config).c_str());
+}
+
+uint64_t hashSettings(const SettingDesc *table, size_t count, const Config &config)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	auto hashBytes = [&hash](const void *data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= static_cast<const unsigned char *>(data)[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	auto hashString = [&hashBytes](const std::string &text)
+	{ hashBytes(text.c_str(), text.size() + 1); };
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const SettingDesc &setting = table[i];
+		switch (setting.type)
+		{
+		case SettingType::Bool:
+			hashBytes(&(config.*setting.boolValue), sizeof(bool));
+			break;
+		case SettingType::Int:
+			hashBytes(&(config.*setting.intValue), sizeof(int));
+			break;
+		case SettingType::Float:
+			hashBytes(&(config.*setting.floatValue), sizeof(float));
+			break;
+		case SettingType::AppList:
+			for (const std::string &app : config.*setting.appListValue)
+				hashString(app);
+			break;
+		}
+	}
+
+	for (const auto &[appKey, profile] : config.appProfiles)
+	{
+		hashString(appKey);
+		for (const auto &[key, value] : profile)
+		{
+			hashString(key);
+			hashString(value);
+		}
+	}
+	return hash;
+}
+
+std::string appListToString(const std::set<std::string> &apps, char separator)
+{
+	std::string result;
+	for (const std::string &app : apps)
+	{
+		if (!result.empty())
+			result += separator;
+		result += app;
+	}
+	return result;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+
+#include "SimpleIni.h"
+
+#include "config.h"
+#include "translations.h"
+
+enum class SettingType
+{
+	Bool,
+	Int,
+	Float,
+	AppList // Space-delimited app keys in the ini, a std::set<std::string> in memory
+};
+
+/**
+ * One entry of the settings table: where it lives in settings.ini,
+ * the member of Config it's loaded into, its default and valid range,
+ * and the translations of its GUI widget.
+ */
+struct SettingDesc
+{
+	const char *section;
+	const char *key;
+	SettingType type;
+	// The member holding the setting, only the one matching type is set
+	bool Config::*boolValue = nullptr;
+	int Config::*intValue = nullptr;
+	float Config::*floatValue = nullptr;
+	std::set<std::string> Config::*appListValue = nullptr;
+	double defaultValue = 0; // Unused for AppList
+	double min = 0;
+	double max = 0;
+	double step = 0;			 // GUI step of Int and Float inputs
+	Str label = Str::None; // No label if the widget is drawn by hand
+	Str tooltip = Str::None;
+	const char *defaultApps = ""; // Default of an AppList
+};
+
+constexpr SettingDesc boolSetting(const char *section, const char *key, bool Config::*value, bool defaultValue,
+								  Str label = Str::None, Str tooltip = Str::None)
+{
+	SettingDesc setting{section, key, SettingType::Bool};
+	setting.boolValue = value;
+	setting.defaultValue = defaultValue;
+	setting.max = 1;
+	setting.label = label;
+	setting.tooltip = tooltip;
+	return setting;
+}
+
+constexpr SettingDesc intSetting(const char *section, const char *key, int Config::*value, int defaultValue, int min, int max,
+								 int step = 0, Str label = Str::None, Str tooltip = Str::None)
+{
+	SettingDesc setting{section, key, SettingType::Int};
+	setting.intValue = value;
+	setting.defaultValue = defaultValue;
+	setting.min = min;
+	setting.max = max;
+	setting.step = step;
+	setting.label = label;
+	setting.tooltip = tooltip;
+	return setting;
+}
+
+constexpr SettingDesc floatSetting(const char *section, const char *key, float Config::*value, double defaultValue, double min, double max,
+								   double step = 0, Str label = Str::None, Str tooltip = Str::None)
+{
+	SettingDesc setting{section, key, SettingType::Float};
+	setting.floatValue = value;
+	setting.defaultValue = defaultValue;
+	setting.min = min;
+	setting.max = max;
+	setting.step = step;
+	setting.label = label;
+	setting.tooltip = tooltip;
+	return setting;
+}
+
+constexpr SettingDesc appListSetting(const char *section, const char *key, std::set<std::string> Config::*value, const char *defaultApps)
+{
+	SettingDesc setting{section, key, SettingType::AppList};
+	setting.appListValue = value;
+	setting.defaultApps = defaultApps;
+	return setting;
+}
+
+/// Returns the entry for key, or nullptr if there is none
+const SettingDesc *findSetting(const SettingDesc *table, size_t count, const char *key);
+
+/// Sets every setting of config to its default
+void resetSettings(const SettingDesc *table, size_t count, Config &config);
+
+/// Clamps a setting of config to its range
+void clampSetting(const SettingDesc &setting, Config &config);
+
+/// Parses the whole of text into a setting of config and clamps it, false (leaving it as it was) if it isn't a valid value
+bool parseSetting(const SettingDesc &setting, const char *text, Config &config);
+
+/// A setting of config as it's written in the ini
+std::string formatSetting(const SettingDesc &setting, const Config &config);
+
+/**
+ * Reads every setting present in ini into config. Values that don't parse are left
+ * as they were and out of range values are clamped, without affecting the others.
+ * Returns the number of values that were invalid or out of range.
+ */
+int parseSettings(const CSimpleIniA &ini, const SettingDesc *table, size_t count, Config &config);
+
+/// Writes every setting of config to ini
+void serializeSettings(CSimpleIniA &ini, const SettingDesc *table, size_t count, const Config &config);
+
+/// Hash of the values of config (app profiles included), to tell whether anything changed
+uint64_t hashSettings(const SettingDesc *table, size_t count, const Config &config);
+
+/// App list to a string, one app per separator
+std::string appListToString(const std::set<std::string> &apps, char separator);
@@ -0,0 +1,125 @@
+#include "settings_writer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <fmt/core.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static std::mutex writerMutex;
+static std::condition_variable writerWake;
+static std::thread writerThread;
+static bool stopping = false;
+static std::chrono::milliseconds debounce{0};
+
+// Latest contents of each file waiting to be written
+static std::map<std::string, std::string> pendingWrites;
+static std::chrono::steady_clock::time_point lastQueuedTime;
+
+/// Writes contents next to path and renames it over path once it's on disk
+static bool writeFileAtomic(const std::string &path, const std::string &contents)
+{
+	std::string tempPath = path + ".tmp";
+	FILE *file = fopen(tempPath.c_str(), "wb");
+	if (!file)
+		return false;
+
+	bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size() && fflush(file) == 0;
+	// Make sure the data is on disk before the rename makes it the real file
+#ifdef _WIN32
+	written = written && _commit(_fileno(file)) == 0;
+#else
+	written = written && fsync(fileno(file)) == 0;
+#endif
+	written = fclose(file) == 0 && written;
+
+	std::error_code ec;
+	if (written)
+		std::filesystem::rename(tempPath, path, ec);
+	if (!written || ec)
+	{
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
+
+static void writePendingFiles(std::unique_lock<std::mutex> &lock)
+{
+	std::map<std::string, std::string> writes;
+	writes.swap(pendingWrites);
+
+	lock.unlock();
+	for (const auto &[path, contents] : writes)
+	{
+		if (!writeFileAtomic(path, contents))
+			std::cout << fmt::format("Failed to write {}", path) << std::endl;
+	}
+	lock.lock();
+}
+
+static void writerLoop()
+{
+	std::unique_lock<std::mutex> lock(writerMutex);
+	while (true)
+	{
+		writerWake.wait(lock, []
+						{ return !pendingWrites.empty() || stopping; });
+		if (pendingWrites.empty())
+			break;
+
+		// Wait for the burst of changes to end
+		while (!stopping && std::chrono::steady_clock::now() < lastQueuedTime + debounce)
+			writerWake.wait_until(lock, lastQueuedTime + debounce);
+
+		writePendingFiles(lock);
+	}
+}
+
+void startSettingsWriter(int debounceMs)
+{
+	std::lock_guard<std::mutex> lock(writerMutex);
+	if (writerThread.joinable())
+		return;
+
+	debounce = std::chrono::milliseconds(debounceMs);
+	stopping = false;
+	writerThread = std::thread(writerLoop);
+}
+
+void queueSettingsWrite(const std::string &path, std::string contents)
+{
+	std::unique_lock<std::mutex> lock(writerMutex);
+	pendingWrites[path] = std::move(contents);
+	lastQueuedTime = std::chrono::steady_clock::now();
+
+	// Without the thread (not started or already stopped), write right away
+	if (!writerThread.joinable())
+	{
+		writePendingFiles(lock);
+		return;
+	}
+	writerWake.notify_one();
+}
+
+void stopSettingsWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(writerMutex);
+		stopping = true;
+	}
+	writerWake.notify_one();
+	if (writerThread.joinable())
+		writerThread.join();
+}
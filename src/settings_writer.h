@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+/**
+ * Writes settings files on a background thread so saving never waits on the disk.
+ * Writes queued in a burst are coalesced into one, and each file is written to a
+ * temporary file that then replaces it, so a crash mid-write can't corrupt it.
+ */
+
+/// Starts the writer thread, a write happens once nothing was queued for debounceMs
+void startSettingsWriter(int debounceMs);
+
+/// Queues contents to be written to path, replacing any write to it still pending
+void queueSettingsWrite(const std::string &path, std::string contents);
+
+/// Writes whatever is still pending and stops the writer thread
+void stopSettingsWriter();
@@ -0,0 +1,81 @@
+#include "telemetry_history.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Slots next to the writer the reader leaves alone, the writer publishing a few samples per second
+static constexpr const uint64_t readerSlack = 16;
+
+void initTelemetryRing(TelemetryRing &ring, int capacity)
+{
+	ring.samples.assign(std::max(capacity, (int)readerSlack * 2), TelemetrySample());
+	ring.written.store(0, std::memory_order_relaxed);
+}
+
+void publishTelemetrySample(TelemetryRing &ring, const TelemetrySample &sample)
+{
+	uint64_t written = ring.written.load(std::memory_order_relaxed);
+	ring.samples[written % ring.samples.size()] = sample;
+	ring.written.store(written + 1, std::memory_order_release);
+}
+
+void accumulateTelemetryFrames(TelemetryAccumulator &accumulator, const float *gpuTimes, const float *cpuTimes, int frames)
+{
+	for (int i = 0; i < frames; i++)
+	{
+		accumulator.gpuTimeSum += gpuTimes[i];
+		accumulator.cpuTimeSum += cpuTimes[i];
+	}
+	accumulator.frames += frames;
+}
+
+bool takeTelemetrySample(TelemetryAccumulator &accumulator, long long nowMs, int intervalMs, TelemetrySample &sample)
+{
+	if (nowMs - accumulator.lastSampleMs < intervalMs)
+		return false;
+
+	sample.timeMs = nowMs;
+	if (accumulator.frames > 0)
+	{
+		sample.gpuTimeMs = (float)(accumulator.gpuTimeSum / accumulator.frames);
+		sample.cpuTimeMs = (float)(accumulator.cpuTimeSum / accumulator.frames);
+	}
+	accumulator = TelemetryAccumulator();
+	accumulator.lastSampleMs = nowMs;
+	return true;
+}
+
+bool downsampleTelemetry(const TelemetryRing &ring, float TelemetrySample::*field, long long nowMs, long long spanMs,
+						 int columns, float *mins, float *maxs)
+{
+	uint64_t capacity = ring.samples.size();
+	long long startMs = nowMs - spanMs;
+	while (true)
+	{
+		std::fill(mins, mins + columns, NAN);
+		std::fill(maxs, maxs + columns, NAN);
+
+		uint64_t written = ring.written.load(std::memory_order_acquire);
+		uint64_t available = std::min(written, capacity - readerSlack);
+		bool any = false;
+		for (uint64_t i = 0; i < available; i++)
+		{
+			const TelemetrySample &sample = ring.samples[(written - 1 - i) % capacity];
+			if (sample.timeMs < startMs)
+				break;
+			if (sample.timeMs > nowMs)
+				continue;
+
+			int column = std::min((int)((sample.timeMs - startMs) * columns / std::max(spanMs, 1ll)), columns - 1);
+			float value = sample.*field;
+			mins[column] = std::isnan(mins[column]) ? value : std::min(mins[column], value);
+			maxs[column] = std::isnan(maxs[column]) ? value : std::max(maxs[column], value);
+			any = true;
+		}
+
+		// Start over if the writer may have overwritten what we read
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (ring.written.load(std::memory_order_relaxed) - written < readerSlack)
+			return any;
+	}
+}
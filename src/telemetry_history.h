@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// One point of the history graphs
+struct TelemetrySample
+{
+	long long timeMs = 0;
+	float gpuTimeMs = 0; // Mean over the frames since the previous sample
+	float cpuTimeMs = 0;
+	float targetFrametimeMs = 0;
+	float resolution = 0;
+	float vramUsed = 0; // In %
+	float gpuUsage = 0; // In %
+};
+
+/**
+ * Fixed-size ring of samples written by the sampler and read by the GUI without locks.
+ * The writer never waits. The reader leaves out the oldest slots, which the writer
+ * could reach while it reads, and starts over if the writer got that far anyway.
+ */
+struct TelemetryRing
+{
+	std::vector<TelemetrySample> samples; // Allocated once
+	std::atomic<uint64_t> written{0};	  // Samples published since the start
+};
+
+/// Frames accumulated by the sampler between two samples
+struct TelemetryAccumulator
+{
+	double gpuTimeSum = 0;
+	double cpuTimeSum = 0;
+	int frames = 0;
+	long long lastSampleMs = 0;
+};
+
+void initTelemetryRing(TelemetryRing &ring, int capacity);
+
+/// Single writer only
+void publishTelemetrySample(TelemetryRing &ring, const TelemetrySample &sample);
+
+/// Adds the frametimes of frames new frames
+void accumulateTelemetryFrames(TelemetryAccumulator &accumulator, const float *gpuTimes, const float *cpuTimes, int frames);
+
+/**
+ * If intervalMs passed since the last sample, sets the time and frametimes of sample
+ * from the accumulated frames (keeping the previous ones if there were none), starts
+ * a new interval and returns true.
+ */
+bool takeTelemetrySample(TelemetryAccumulator &accumulator, long long nowMs, int intervalMs, TelemetrySample &sample);
+
+/**
+ * Min and max of field per column, the last spanMs before nowMs being split into
+ * columns equal slices (oldest first). Columns without samples get NaN.
+ * Costs one pass over the samples in the span, whatever the width.
+ * Returns false if there are no samples in the span.
+ */
+bool downsampleTelemetry(const TelemetryRing &ring, float TelemetrySample::*field, long long nowMs, long long spanMs,
+						 int columns, float *mins, float *maxs);
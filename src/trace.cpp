@@ -0,0 +1,128 @@
+#include "trace.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <fmt/core.h>
+
+static FILE *traceFile = nullptr;
+static FILE *frameTraceFile = nullptr;
+
+static constexpr const char *traceHeader =
+	"timeMs,appKey,fps,gpuTime,cpuTime,resolution,newResolution,vramUsed,gpuUsage,"
+	"presentsPerSecond,droppedPerSecond,reprojectedPerSecond,timedOutPerSecond,loadingPerSecond,"
+	"startupPresentsPerSecond,startupDroppedPerSecond,startupReprojectedPerSecond,loadingDroppedPerSecond,loadingReprojectedPerSecond,"
+	"timedOutDroppedPerSecond,timedOutReprojectedPerSecond,submitsPerSecond,submitsWithDepthPerSecond,"
+	"applicationCpuMs,applicationGpuMs,compositorCpuMs,compositorGpuMs,targetFrameMs,"
+	"transition,changePoints,frameSpikes,gpuOutliers,jitterMs,judder,maxMissedVsyncs,vramTrend,vramSecondsToLimit\n";
+
+/// Whether the file at path starts with header, or is missing or empty
+static bool hasCurrentHeader(const char *path, const char *header)
+{
+	FILE *file = fopen(path, "r");
+	if (!file)
+		return true;
+
+	char firstLine[1024] = {};
+	bool matches = !fgets(firstLine, sizeof(firstLine), file) || strcmp(firstLine, header) == 0;
+	fclose(file);
+	return matches;
+}
+
+static FILE *openTraceFile(const char *path, const char *header)
+{
+	// Written by a build with other columns, move it aside rather than appending rows that don't match its header
+	if (!hasCurrentHeader(path, header))
+	{
+		std::string oldPath = std::string(path) + ".old";
+		remove(oldPath.c_str());
+		if (rename(path, oldPath.c_str()) != 0)
+			remove(path);
+	}
+
+	FILE *file = fopen(path, "a");
+	if (!file)
+		return nullptr;
+
+	// New file, describe the columns
+	fseek(file, 0, SEEK_END);
+	if (ftell(file) == 0)
+		fputs(header, file);
+	return file;
+}
+
+bool openTrace(const char *path)
+{
+	closeTrace();
+	traceFile = openTraceFile(path, traceHeader);
+	return traceFile != nullptr;
+}
+
+bool isTraceOpen()
+{
+	return traceFile != nullptr;
+}
+
+void writeTraceRow(const TraceRow &row)
+{
+	if (!traceFile)
+		return;
+
+	std::string line = fmt::format("{},{},{:.2f},{:.3f},{:.3f},{:.1f},{:.1f},{:.3f},{},"
+								   "{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},{:.2f},"
+								   "{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},"
+								   "{:d},{},{},{},{:.3f},{:.1f},{},{:.5f},{:.1f}\n",
+								   row.timeMs, row.appKey, row.fps, row.gpuTime, row.cpuTime, row.resolution, row.newResolution,
+								   row.vramUsed, row.gpuUsage, row.presentsPerSecond, row.droppedPerSecond, row.reprojectedPerSecond,
+								   row.timedOutPerSecond, row.loadingPerSecond, row.startupPresentsPerSecond, row.startupDroppedPerSecond,
+								   row.startupReprojectedPerSecond, row.loadingDroppedPerSecond, row.loadingReprojectedPerSecond,
+								   row.timedOutDroppedPerSecond, row.timedOutReprojectedPerSecond, row.submitsPerSecond,
+								   row.submitsWithDepthPerSecond, row.applicationCpuMs, row.applicationGpuMs, row.compositorCpuMs,
+								   row.compositorGpuMs, row.targetFrameMs, (int)row.transition, row.changePoints,
+								   row.frameSpikes, row.gpuOutliers, row.jitterMs, row.judder, row.maxMissedVsyncs,
+								   row.vramTrend, row.vramSecondsToLimit);
+	fputs(line.c_str(), traceFile);
+	fflush(traceFile);
+}
+
+void closeTrace()
+{
+	if (traceFile)
+	{
+		fclose(traceFile);
+		traceFile = nullptr;
+	}
+}
+
+bool openFrameTrace(const char *path)
+{
+	closeFrameTrace();
+	frameTraceFile = openTraceFile(path, frameTraceHeader);
+	return frameTraceFile != nullptr;
+}
+
+bool isFrameTraceOpen()
+{
+	return frameTraceFile != nullptr;
+}
+
+void writeFrameTraceRow(const FrameTraceRow &row)
+{
+	if (!frameTraceFile)
+		return;
+
+	std::string line = fmt::format("{:.6f},{},{},{:.3f},{:.3f},{},{:d},{:d},{:d}\n",
+								   row.timeS, frameTraceEvents[(int)row.event], row.frameIndex, row.gpuTime, row.cpuTime,
+								   row.gpuUsage, (int)row.settling, (int)row.changePoint, (int)row.transition);
+	fputs(line.c_str(), frameTraceFile);
+}
+
+void closeFrameTrace()
+{
+	if (frameTraceFile)
+	{
+		fclose(frameTraceFile);
+		frameTraceFile = nullptr;
+	}
+}
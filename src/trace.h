@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/// One row of the trace, written every resolution decision
+struct TraceRow
+{
+	long long timeMs = 0;
+	std::string appKey;
+	float fps = 0;
+	float gpuTime = 0;
+	float cpuTime = 0;
+	float resolution = 0; // Resolution the decision was made at
+	float newResolution = 0;
+	float vramUsed = 0;
+	int gpuUsage = 0;
+	// From the cumulative stats
+	float presentsPerSecond = 0;
+	float droppedPerSecond = 0;
+	float reprojectedPerSecond = 0;
+	float timedOutPerSecond = 0;
+	float loadingPerSecond = 0;
+	float startupPresentsPerSecond = 0;
+	float startupDroppedPerSecond = 0;
+	float startupReprojectedPerSecond = 0;
+	float loadingDroppedPerSecond = 0;
+	float loadingReprojectedPerSecond = 0;
+	float timedOutDroppedPerSecond = 0;
+	float timedOutReprojectedPerSecond = 0;
+	float submitsPerSecond = 0;
+	float submitsWithDepthPerSecond = 0;
+	// Means per submitted frame
+	float applicationCpuMs = 0;
+	float applicationGpuMs = 0;
+	float compositorCpuMs = 0;
+	float compositorGpuMs = 0;
+	float targetFrameMs = 0;
+	// Scene transition detection
+	bool transition = false;
+	int changePoints = 0;
+	// Outlier rejection
+	int frameSpikes = 0; // Isolated spikes logged since startup
+	int gpuOutliers = 0; // GPU frametimes rejected in this window
+	// Frame pacing
+	float jitterMs = 0;
+	float judder = 0;
+	int maxMissedVsyncs = 0;
+	// VRAM forecast
+	float vramTrend = 0;		  // Fraction of the total per second
+	float vramSecondsToLimit = -1; // Negative if not rising
+};
+
+/// Opens path for appending rows, writing the CSV header if the file is new
+bool openTrace(const char *path);
+
+bool isTraceOpen();
+
+void writeTraceRow(const TraceRow &row);
+
+void closeTrace();
+
+enum class FrameTraceEvent
+{
+	Frame, // A frame the transition detector was fed (or skipped while settling)
+	Usage, // A GPU utilization sample
+	Reset, // The detector forgot its baseline
+};
+
+static constexpr const char *frameTraceHeader = "timeS,event,frameIndex,gpuTime,cpuTime,gpuUsage,settling,changePoint,transition\n";
+// Written in the event column, by FrameTraceEvent
+static constexpr const char *frameTraceEvents[] = {"frame", "usage", "reset"};
+
+/// One row of the frame trace, enough to replay the transition detector offline
+struct FrameTraceRow
+{
+	double timeS = 0; // Compositor time
+	FrameTraceEvent event = FrameTraceEvent::Frame;
+	uint32_t frameIndex = 0;
+	float gpuTime = 0;
+	float cpuTime = 0;
+	int gpuUsage = 0;
+	bool settling = false;	  // Not fed to the detector, a resolution change was being measured
+	bool changePoint = false; // The detector flagged a shift on this row
+	bool transition = false;  // Adjustments were frozen for a scene transition
+};
+
+/// Opens path for appending frame rows, writing the CSV header if the file is new
+bool openFrameTrace(const char *path);
+
+bool isFrameTraceOpen();
+
+/// Buffered, a row per frame is too many to flush each
+void writeFrameTraceRow(const FrameTraceRow &row);
+
+void closeFrameTrace();
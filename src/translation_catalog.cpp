@@ -0,0 +1,170 @@
+#include "translation_catalog.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char *mappedData = nullptr;
+static size_t mappedSize = 0;
+static std::string_view catalogStrings[(size_t)Str::Count];
+static bool catalogLoaded = false;
+
+#ifdef _WIN32
+static HANDLE mappingHandle = nullptr;
+#endif
+
+static bool isCompatibleHeader(const TranslationCatalogHeader &header)
+{
+	return memcmp(header.magic, translationCatalogMagic, sizeof(header.magic)) == 0 &&
+		   header.version == translationCatalogVersion &&
+		   header.idsHash == hashTranslationIds() &&
+		   header.stringCount == (uint32_t)Str::Count;
+}
+
+static bool mapFile(const std::string &path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	// The mapping keeps the file open
+	mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mappingHandle)
+		return false;
+	mappedData = static_cast<const char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (!mappedData)
+	{
+		CloseHandle(mappingHandle);
+		mappingHandle = nullptr;
+		return false;
+	}
+	mappedSize = (size_t)size.QuadPart;
+#else
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+	struct stat info;
+	if (fstat(fd, &info) < 0 || info.st_size == 0)
+	{
+		close(fd);
+		return false;
+	}
+	void *data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+	mappedData = static_cast<const char *>(data);
+	mappedSize = (size_t)info.st_size;
+#endif
+	return true;
+}
+
+static void unmapFile()
+{
+	if (!mappedData)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(mappedData);
+	CloseHandle(mappingHandle);
+	mappingHandle = nullptr;
+#else
+	munmap(const_cast<char *>(mappedData), mappedSize);
+#endif
+	mappedData = nullptr;
+	mappedSize = 0;
+}
+
+/// Builds the index from the offsets, false if the file is truncated or they point outside of it
+static bool indexCatalog()
+{
+	const size_t stringCount = (size_t)Str::Count;
+	const size_t dataStart = sizeof(TranslationCatalogHeader) + (stringCount + 1) * sizeof(uint32_t);
+	if (mappedSize < dataStart)
+		return false;
+
+	TranslationCatalogHeader header;
+	memcpy(&header, mappedData, sizeof(header));
+	if (!isCompatibleHeader(header) || header.nameOffset < dataStart || header.nameOffset >= mappedSize)
+		return false;
+
+	// The data ends with a null, so even a string with a wrong offset can't be read past the mapping
+	if (mappedData[mappedSize - 1] != '\0')
+		return false;
+
+	const char *offsets = mappedData + sizeof(TranslationCatalogHeader);
+	uint32_t start;
+	memcpy(&start, offsets, sizeof(start));
+	for (size_t i = 0; i < stringCount; i++)
+	{
+		uint32_t end;
+		memcpy(&end, offsets + (i + 1) * sizeof(uint32_t), sizeof(end));
+		if (start < dataStart || end <= start || end > mappedSize)
+			return false;
+		catalogStrings[i] = std::string_view(mappedData + start, end - start - 1); // Without the null
+		start = end;
+	}
+	return true;
+}
+
+bool loadTranslationCatalog(const std::string &path)
+{
+	unloadTranslationCatalog();
+	if (!mapFile(path))
+		return false;
+	if (!indexCatalog())
+	{
+		unmapFile();
+		return false;
+	}
+	catalogLoaded = true;
+	return true;
+}
+
+void unloadTranslationCatalog()
+{
+	catalogLoaded = false;
+	for (std::string_view &text : catalogStrings)
+		text = std::string_view();
+	unmapFile();
+}
+
+const std::string_view *getTranslationCatalogStrings()
+{
+	return catalogLoaded ? catalogStrings : nullptr;
+}
+
+bool readTranslationCatalogName(const std::string &path, std::string &name)
+{
+	FILE *file = fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+
+	TranslationCatalogHeader header;
+	bool valid = fread(&header, sizeof(header), 1, file) == 1 && isCompatibleHeader(header) &&
+				 fseek(file, (long)header.nameOffset, SEEK_SET) == 0;
+	if (valid)
+	{
+		char buffer[64] = {};
+		size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+		name.assign(buffer, strnlen(buffer, length));
+		valid = !name.empty();
+	}
+	fclose(file);
+	return valid;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "translations.h"
+
+/**
+ * Binary translation catalog, one file per language compiled from translations/<code>.ini
+ * by catalog_compiler:
+ *
+ *   TranslationCatalogHeader
+ *   uint32_t offsets[stringCount + 1]  Start of each string in the file, the last one is the end of the data
+ *   char data[]                        The name of the language then every string, each null-terminated
+ *
+ * Strings are in the order of the Str enum, so a catalog is only used if it was compiled
+ * against the same IDs (idsHash). All values are little-endian.
+ */
+
+static constexpr const char translationCatalogMagic[4] = {'O', 'D', 'R', 'T'};
+static constexpr const uint32_t translationCatalogVersion = 1;
+static constexpr const char *translationCatalogDirectory = "translations";
+static constexpr const char *translationCatalogExtension = ".cat";
+
+struct TranslationCatalogHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t idsHash;
+	uint32_t stringCount; // Str::Count, string 0 (Str::None) is empty
+	uint32_t nameOffset;  // Name of the language, shown in the language list
+};
+
+/**
+ * Memory-maps the catalog at path, replacing the one loaded before. Only the offsets are read
+ * to build the index, the strings are paged in as they're displayed.
+ * False (leaving no catalog loaded) if it's missing, invalid or compiled for other IDs.
+ */
+bool loadTranslationCatalog(const std::string &path);
+
+void unloadTranslationCatalog();
+
+/// Index of the loaded catalog by Str, nullptr if there's none
+const std::string_view *getTranslationCatalogStrings();
+
+/// Reads only the name of the language of the catalog at path, false if it isn't a valid catalog
+bool readTranslationCatalogName(const std::string &path, std::string &name);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// Translation IDs, one per entry of translations.inc
+enum class Str : uint16_t
+{
+	None, // Empty in every language
+#define TRANSLATION(id, english) id,
+#include "translations.inc"
+#undef TRANSLATION
+	Count
+};
+
+/// Name of every translation ID, as written in the catalog sources
+inline constexpr std::string_view translationIds[(size_t)Str::Count] = {
+	"",
+#define TRANSLATION(id, english) #id,
+#include "translations.inc"
+#undef TRANSLATION
+};
+
+/// English text of every translation ID, null-terminated. Used when no catalog is loaded.
+inline constexpr std::string_view builtinTranslations[(size_t)Str::Count] = {
+	"",
+#define TRANSLATION(id, english) english,
+#include "translations.inc"
+#undef TRANSLATION
+};
+
+/// Number of replacement fields in a format string ({{ and }} being escapes)
+constexpr size_t countPlaceholders(std::string_view format)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < format.size(); i++)
+	{
+		if (format[i] != '{')
+			continue;
+		if (i + 1 < format.size() && format[i + 1] == '{')
+			i++;
+		else
+			count++;
+	}
+	return count;
+}
+
+/// Whether two format strings have the same replacement fields (format specs included) in the same order
+constexpr bool samePlaceholders(std::string_view a, std::string_view b)
+{
+	size_t i = 0;
+	size_t j = 0;
+	while (true)
+	{
+		// Next replacement field of each, skipping escapes
+		while (i < a.size() && (a[i] != '{' || (i + 1 < a.size() && a[i + 1] == '{')))
+			i += a[i] == '{' ? 2 : 1;
+		while (j < b.size() && (b[j] != '{' || (j + 1 < b.size() && b[j + 1] == '{')))
+			j += b[j] == '{' ? 2 : 1;
+		if (i >= a.size() || j >= b.size())
+			return i >= a.size() && j >= b.size();
+
+		size_t endA = a.find('}', i);
+		size_t endB = b.find('}', j);
+		if (a.substr(i, endA - i) != b.substr(j, endB - j))
+			return false;
+		i = endA;
+		j = endB;
+	}
+}
+
+/**
+ * FNV-1a of the ID names in order and of the placeholders of their English text.
+ * A catalog is only used with the IDs and placeholders it was compiled against,
+ * as its strings are indexed by Str and formatted with the same arguments.
+ */
+constexpr uint32_t hashTranslationIds()
+{
+	uint32_t hash = 2166136261u;
+	auto hashText = [&hash](std::string_view text)
+	{
+		for (char c : text)
+		{
+			hash ^= (unsigned char)c;
+			hash *= 16777619u;
+		}
+		hash *= 16777619u; // Null separator
+	};
+	for (size_t i = 0; i < (size_t)Str::Count; i++)
+	{
+		hashText(translationIds[i]);
+		std::string_view english = builtinTranslations[i];
+		for (size_t start = english.find('{'); start != std::string_view::npos; start = english.find('{', start + 1))
+		{
+			if (start + 1 < english.size() && english[start + 1] == '{')
+			{
+				start++; // Escaped
+				continue;
+			}
+			hashText(english.substr(start, english.find('}', start) - start));
+		}
+	}
+	return hash;
+}
@@ -0,0 +1,68 @@
+#include "vram_forecast.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Weight of a new sample in the level and in the trend
+static constexpr const float levelSmoothing = 0.5f;
+static constexpr const float trendSmoothing = 0.2f;
+// Colour (RGBA8) and depth (D24S8 or D32) per eye, and the compositor's colour copy
+static constexpr const float bytesPerPixel = 4 + 4 + 4;
+// Don't back off more than this many percents in one decision
+static constexpr const int maxBackOffSteps = 30;
+
+void updateVramForecast(VramForecast &forecast, float vramUsed, long long nowMs)
+{
+	if (!forecast.initialized)
+	{
+		forecast.initialized = true;
+		forecast.level = vramUsed;
+		forecast.trend = 0;
+		forecast.lastTimeMs = nowMs;
+		return;
+	}
+
+	float seconds = (nowMs - forecast.lastTimeMs) / 1000.0f;
+	if (seconds <= 0)
+		return;
+
+	// Samples aren't evenly spaced, so the trend is per second rather than per sample
+	float previousLevel = forecast.level;
+	float predicted = forecast.level + forecast.trend * seconds;
+	forecast.level = levelSmoothing * vramUsed + (1 - levelSmoothing) * predicted;
+	forecast.trend = trendSmoothing * (forecast.level - previousLevel) / seconds + (1 - trendSmoothing) * forecast.trend;
+	forecast.lastTimeMs = nowMs;
+}
+
+float forecastVramUsed(const VramForecast &forecast, float seconds)
+{
+	return forecast.level + forecast.trend * seconds;
+}
+
+float getSecondsToVramLimit(const VramForecast &forecast, float limit)
+{
+	if (!forecast.initialized)
+		return -1;
+	if (forecast.level >= limit)
+		return 0;
+	if (forecast.trend <= 0)
+		return -1;
+	return (limit - forecast.level) / forecast.trend;
+}
+
+float getVramPerResStepGB(uint32_t renderWidth, uint32_t renderHeight, float currentRes)
+{
+	if (currentRes <= 0)
+		return 0;
+	// The pixel count scales linearly with the resolution percent
+	float bytes = (float)renderWidth * (float)renderHeight * 2 * bytesPerPixel;
+	return bytes / currentRes / (1024.0f * 1024.0f * 1024.0f);
+}
+
+int getVramBackOffSteps(float excessGB, float vramPerStepGB, int minStep)
+{
+	if (vramPerStepGB <= 0 || excessGB <= 0)
+		return minStep;
+	int steps = (int)std::ceil(excessGB / vramPerStepGB);
+	return std::clamp(steps, minStep, std::max(minStep, maxBackOffSteps));
+}
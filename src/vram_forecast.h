@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Holt (level + trend) smoothing of the VRAM usage, to see a limit
+ * coming before the game starts paging textures over PCIe.
+ */
+struct VramForecast
+{
+	bool initialized = false;
+	float level = 0;	  // Smoothed VRAM usage, as a fraction of the total
+	float trend = 0;	  // Change of the usage per second
+	long long lastTimeMs = 0;
+};
+
+/// Adds a VRAM usage sample (fraction of the total) taken at nowMs
+void updateVramForecast(VramForecast &forecast, float vramUsed, long long nowMs);
+
+/// Usage expected in seconds from the last sample
+float forecastVramUsed(const VramForecast &forecast, float seconds);
+
+/// Seconds until the usage crosses limit (fraction of the total), negative if it isn't rising towards it
+float getSecondsToVramLimit(const VramForecast &forecast, float limit);
+
+/**
+ * Rough VRAM cost in GB of one resolution percent, from the per-eye render target
+ * size at currentRes: both eyes' colour and depth, plus the compositor's copy.
+ */
+float getVramPerResStepGB(uint32_t renderWidth, uint32_t renderHeight, float currentRes);
+
+/// Resolution percents to drop to free excessGB, at least minStep
+int getVramBackOffSteps(float excessGB, float vramPerStepGB, int minStep);
@@ -0,0 +1,116 @@
+// Compiles a translation source (translations/<code>.ini) into the binary catalog the app
+// memory-maps (see translation_catalog.h), checking it against src/translations.inc:
+// every ID has to be translated, no unknown ones, and the placeholders have to match the English text.
+// Usage: catalog_compiler <source.ini> <output.cat>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "SimpleIni.h"
+
+#include "translation_catalog.h"
+
+static int errors = 0;
+
+static void reportError(const char *source, const std::string &message)
+{
+	fprintf(stderr, "%s: error: %s\n", source, message.c_str());
+	errors++;
+}
+
+static bool writeCatalog(const char *path, const std::string &name, const std::vector<std::string> &strings)
+{
+	const uint32_t stringCount = (uint32_t)Str::Count;
+	const uint32_t dataStart = sizeof(TranslationCatalogHeader) + (stringCount + 1) * sizeof(uint32_t);
+
+	// The name first, then the strings in the order of Str
+	std::string data = name;
+	data += '\0';
+	std::vector<uint32_t> offsets;
+	for (const std::string &text : strings)
+	{
+		offsets.push_back(dataStart + (uint32_t)data.size());
+		data += text;
+		data += '\0';
+	}
+	offsets.push_back(dataStart + (uint32_t)data.size());
+
+	TranslationCatalogHeader header = {};
+	std::copy(std::begin(translationCatalogMagic), std::end(translationCatalogMagic), header.magic);
+	header.version = translationCatalogVersion;
+	header.idsHash = hashTranslationIds();
+	header.stringCount = stringCount;
+	header.nameOffset = dataStart;
+
+	FILE *file = fopen(path, "wb");
+	if (!file)
+		return false;
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+				   fwrite(offsets.data(), sizeof(uint32_t), offsets.size(), file) == offsets.size() &&
+				   fwrite(data.data(), 1, data.size(), file) == data.size();
+	return fclose(file) == 0 && written;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <source.ini> <output.cat>\n", argv[0]);
+		return 2;
+	}
+	const char *source = argv[1];
+
+	CSimpleIniCaseA ini(true, true); // UTF-8, duplicate keys kept so they can be reported
+	if (ini.LoadFile(source) < 0)
+	{
+		reportError(source, "can't be read");
+		return 1;
+	}
+
+	std::string name = ini.GetValue("Catalog", "name", "");
+	if (name.empty())
+		reportError(source, "[Catalog] has no name");
+
+	std::vector<std::string> strings((size_t)Str::Count);
+	for (size_t i = 1; i < (size_t)Str::Count; i++)
+	{
+		std::string id(translationIds[i]);
+		bool duplicated = false;
+		const char *text = ini.GetValue("Strings", id.c_str(), nullptr, &duplicated);
+		if (!text)
+		{
+			reportError(source, id + " is missing");
+			continue;
+		}
+		if (duplicated)
+			reportError(source, id + " is translated more than once");
+		if (!samePlaceholders(builtinTranslations[i], text))
+			reportError(source, id + " doesn't have the placeholders of the English text \"" + std::string(builtinTranslations[i]) + "\"");
+		strings[i] = text;
+	}
+
+	CSimpleIniCaseA::TNamesDepend keys;
+	ini.GetAllKeys("Strings", keys);
+	for (const auto &key : keys)
+	{
+		bool known = false;
+		for (size_t i = 1; i < (size_t)Str::Count && !known; i++)
+			known = translationIds[i] == key.pItem;
+		if (!known)
+			reportError(source, std::string(key.pItem) + " isn't a translation ID (removed or misspelled?)");
+	}
+
+	if (errors)
+	{
+		fprintf(stderr, "%s: %d error(s), catalog not written\n", source, errors);
+		return 1;
+	}
+	if (!writeCatalog(argv[2], name, strings))
+	{
+		fprintf(stderr, "%s: can't be written\n", argv[2]);
+		return 1;
+	}
+	return 0;
+}